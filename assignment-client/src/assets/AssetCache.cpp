@@ -0,0 +1,116 @@
+//
+//  AssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetCache.h"
+
+#include <QtCore/QFile>
+
+const qint64 AssetCache::DEFAULT_MAX_SIZE = 128 * 1000 * 1000;
+
+// a single asset may only take this much of the cache, larger ones are read from disk every time
+static const int MAX_ASSET_SIZE_DIVISOR = 8;
+
+AssetCache::AssetCache(qint64 maxSize) :
+    _maxSize(maxSize)
+{
+}
+
+void AssetCache::setMaxSize(qint64 maxSize) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxSize = maxSize;
+    evict();
+}
+
+int AssetCache::getNumAssets() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entriesByHash.size();
+}
+
+QByteArray AssetCache::readFile(const QString& filePath) const {
+    QFile file { filePath };
+    if (!file.open(QIODevice::ReadOnly) || file.size() > _maxSize / MAX_ASSET_SIZE_DIVISOR) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void AssetCache::evict() {
+    while (_size > _maxSize && !_entries.empty()) {
+        auto& leastRecentlyUsed = _entries.back();
+        _size -= leastRecentlyUsed.data.size();
+        _entriesByHash.remove(leastRecentlyUsed.hash);
+        _entries.pop_back();
+    }
+}
+
+QByteArray AssetCache::get(const AssetUtils::AssetHash& hash, const QString& filePath) {
+    std::promise<QByteArray> readPromise;
+    uint64_t readID;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_maxSize <= 0) {
+            return QByteArray();
+        }
+
+        auto it = _entriesByHash.find(hash);
+        if (it != _entriesByHash.end()) {
+            _entries.splice(_entries.begin(), _entries, it.value());
+            ++_numHits;
+            return it.value()->data;
+        }
+
+        auto pendingRead = _pendingReads.find(hash);
+        if (pendingRead != _pendingReads.end()) {
+            auto readFuture = pendingRead.value().data;
+            lock.unlock();
+            ++_numCoalescedMisses;
+            return readFuture.get();
+        }
+
+        readID = _nextReadID++;
+        _pendingReads.insert(hash, { readID, readPromise.get_future().share() });
+    }
+
+    ++_numMisses;
+    QByteArray data = readFile(filePath);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // the pending read is gone, or belongs to a newer reader, if the asset was removed while it was being read
+        auto pendingRead = _pendingReads.find(hash);
+        bool wasRemoved = pendingRead == _pendingReads.end() || pendingRead.value().id != readID;
+        if (!wasRemoved) {
+            _pendingReads.erase(pendingRead);
+        }
+        if (!wasRemoved && !data.isNull() && data.size() <= _maxSize / MAX_ASSET_SIZE_DIVISOR) {
+            _entries.push_front({ hash, data });
+            _entriesByHash.insert(hash, _entries.begin());
+            _size += data.size();
+            evict();
+        }
+    }
+
+    readPromise.set_value(data);
+    return data;
+}
+
+void AssetCache::remove(const AssetUtils::AssetHash& hash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pendingReads.remove(hash);
+
+    auto it = _entriesByHash.find(hash);
+    if (it != _entriesByHash.end()) {
+        _size -= it.value()->data.size();
+        _entries.erase(it.value());
+        _entriesByHash.erase(it);
+    }
+}
@@ -0,0 +1,85 @@
+//
+//  AssetCache.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetCache_h
+#define hifi_AssetCache_h
+
+#include <atomic>
+#include <future>
+#include <list>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+#include "AssetUtils.h"
+
+/// A size-bounded, least recently used cache of the contents of asset files, shared by the send tasks of the asset server.
+/// Assets are stored by hash, so a cached file never goes stale, it only has to be dropped when the file is deleted
+/// or replaced.
+class AssetCache {
+public:
+    static const qint64 DEFAULT_MAX_SIZE; // bytes
+
+    AssetCache(qint64 maxSize = DEFAULT_MAX_SIZE);
+
+    /// Set the total size of the cached files, 0 turns the cache off.
+    void setMaxSize(qint64 maxSize);
+    qint64 getMaxSize() const { return _maxSize; }
+
+    /// Returns the contents of an asset file, reading it only if it isn't cached yet. Concurrent misses for the same
+    /// asset wait for the one read. Returns a null QByteArray for files that could not be read or are too large
+    /// to cache, the caller reads those itself.
+    QByteArray get(const AssetUtils::AssetHash& hash, const QString& filePath);
+
+    /// Drop an asset whose file was deleted or replaced.
+    void remove(const AssetUtils::AssetHash& hash);
+
+    void countBytesServed(qint64 bytes) { _bytesServed += bytes; }
+
+    uint64_t getNumHits() const { return _numHits; }
+    uint64_t getNumMisses() const { return _numMisses; }
+    uint64_t getNumCoalescedMisses() const { return _numCoalescedMisses; }
+    uint64_t getBytesServed() const { return _bytesServed; }
+    qint64 getSize() const { return _size; }
+    int getNumAssets() const;
+
+private:
+    struct Entry {
+        AssetUtils::AssetHash hash;
+        QByteArray data;
+    };
+
+    struct PendingRead {
+        uint64_t id; // tells a read apart from a newer one for the same asset, started after a remove
+        std::shared_future<QByteArray> data;
+    };
+
+    QByteArray readFile(const QString& filePath) const;
+    void evict(); // with _mutex held
+
+    mutable std::mutex _mutex;
+    std::list<Entry> _entries; // most recently used first, guarded by _mutex
+    QHash<AssetUtils::AssetHash, std::list<Entry>::iterator> _entriesByHash; // guarded by _mutex
+    QHash<AssetUtils::AssetHash, PendingRead> _pendingReads; // guarded by _mutex
+    uint64_t _nextReadID { 0 }; // guarded by _mutex
+
+    std::atomic<qint64> _maxSize;
+    std::atomic<qint64> _size { 0 };
+
+    std::atomic<uint64_t> _numHits { 0 };
+    std::atomic<uint64_t> _numMisses { 0 };
+    std::atomic<uint64_t> _numCoalescedMisses { 0 };
+    std::atomic<uint64_t> _bytesServed { 0 };
+};
+
+#endif // hifi_AssetCache_h
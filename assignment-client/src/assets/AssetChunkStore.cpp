@@ -0,0 +1,217 @@
+//
+//  AssetChunkStore.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkStore.h"
+
+#include <limits>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+#include "AssetServerLogging.h"
+#include "AssetStorage.h"
+
+const QString AssetChunkStore::CHUNKS_SUBDIR = "chunks";
+
+bool AssetChunkStore::load(const AssetStorage& storage) {
+    _storage = &storage;
+    QDir chunksDirectory = storage.getFilesDirectory();
+
+    if (!chunksDirectory.mkpath(CHUNKS_SUBDIR) || !chunksDirectory.cd(CHUNKS_SUBDIR)) {
+        qCWarning(asset_server) << "Unable to create the chunks directory, chunked transfers are turned off.";
+        return false;
+    }
+
+    _chunksPath = chunksDirectory.absolutePath();
+
+    int numAssets = 0;
+    for (const auto& hash : chunksDirectory.entryList(QDir::Files)) {
+        if (!AssetUtils::isValidHash(hash)) {
+            continue;
+        }
+
+        // the asset may have been deleted while its chunks were being listed
+        if (!QFile::exists(_storage->getFilePath(hash))) {
+            chunksDirectory.remove(hash);
+            continue;
+        }
+
+        auto chunks = readChunkList(hash);
+        std::lock_guard<std::mutex> lock(_mutex);
+        addChunks(hash, chunks);
+        ++numAssets;
+    }
+
+    qCInfo(asset_server) << "Loaded the chunks of" << numAssets << "assets," << getNumChunks() << "distinct chunks.";
+
+    _isEnabled = true;
+    return true;
+}
+
+std::vector<AssetUtils::AssetChunk> AssetChunkStore::getChunks(const AssetUtils::AssetHash& hash) {
+    if (!_isEnabled) {
+        return {};
+    }
+
+    auto chunks = readChunkList(hash);
+    if (chunks.empty()) {
+        QFile file { _storage->getFilePath(hash) };
+        if (!file.open(QIODevice::ReadOnly) || file.size() > std::numeric_limits<int>::max()) {
+            return {};
+        }
+
+        // map the file rather than read it into a buffer of its own, it is only looked at once
+        auto size = file.size();
+        uchar* mappedData = size > 0 ? file.map(0, size) : nullptr;
+        if (mappedData) {
+            chunks = AssetUtils::chunkData(QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData), (int)size));
+            file.unmap(mappedData);
+        } else {
+            chunks = AssetUtils::chunkData(file.readAll());
+        }
+
+        if (!writeChunkList(hash, chunks)) {
+            qCWarning(asset_server) << "Failed to write the chunk list of" << hash;
+        }
+    }
+
+    // the chunks are added again every time, in case they were only held by an asset that has since been deleted
+    std::lock_guard<std::mutex> lock(_mutex);
+    addChunks(hash, chunks);
+    return chunks;
+}
+
+std::vector<bool> AssetChunkStore::findChunks(const std::vector<QByteArray>& chunkHashes) const {
+    std::vector<bool> found(chunkHashes.size(), false);
+    if (!_isEnabled) {
+        return found;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t i = 0; i < chunkHashes.size(); ++i) {
+        found[i] = _chunks.contains(chunkHashes[i]);
+    }
+    return found;
+}
+
+QByteArray AssetChunkStore::readChunk(const QByteArray& chunkHash) {
+    ChunkLocation location;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _chunks.find(chunkHash);
+        if (it == _chunks.end()) {
+            return QByteArray();
+        }
+        location = it.value();
+    }
+
+    QByteArray data;
+    QFile file { _storage->getFilePath(location.hash) };
+    if (file.open(QIODevice::ReadOnly) && file.seek(location.offset)) {
+        data = file.read(location.length);
+    }
+
+    // the asset may have been deleted or replaced since its chunks were listed
+    if (data.size() != location.length || AssetUtils::hashData(data) != chunkHash) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _chunks.find(chunkHash);
+        if (it != _chunks.end() && it.value().hash == location.hash) {
+            _chunks.erase(it);
+        }
+        return QByteArray();
+    }
+
+    return data;
+}
+
+void AssetChunkStore::remove(const AssetUtils::AssetHash& hash) {
+    if (!_isEnabled) {
+        return;
+    }
+
+    auto chunks = readChunkList(hash);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        removeChunks(hash, chunks);
+    }
+    QFile::remove(getChunkListPath(hash));
+}
+
+int AssetChunkStore::getNumChunks() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _chunks.size();
+}
+
+QString AssetChunkStore::getChunkListPath(const AssetUtils::AssetHash& hash) const {
+    return _chunksPath + "/" + hash;
+}
+
+std::vector<AssetUtils::AssetChunk> AssetChunkStore::readChunkList(const AssetUtils::AssetHash& hash) const {
+    QFile file { getChunkListPath(hash) };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    // the list holds the length and the hash of each chunk, their offsets follow from the lengths
+    static const qint64 ENTRY_SIZE = sizeof(quint32) + AssetUtils::SHA256_HASH_LENGTH;
+    std::vector<AssetUtils::AssetChunk> chunks;
+    chunks.reserve(file.size() / ENTRY_SIZE);
+
+    QDataStream stream { &file };
+    AssetUtils::DataOffset offset = 0;
+    while (!stream.atEnd()) {
+        quint32 length;
+        QByteArray chunkHash((int)AssetUtils::SHA256_HASH_LENGTH, '\0');
+        stream >> length;
+        if (stream.readRawData(chunkHash.data(), chunkHash.size()) != chunkHash.size() || length == 0) {
+            qCWarning(asset_server) << "The chunk list of" << hash << "is truncated, it will be listed again.";
+            return {};
+        }
+        chunks.push_back({ offset, length, chunkHash });
+        offset += length;
+    }
+    return chunks;
+}
+
+bool AssetChunkStore::writeChunkList(const AssetUtils::AssetHash& hash,
+                                     const std::vector<AssetUtils::AssetChunk>& chunks) const {
+    QSaveFile file { getChunkListPath(hash) };
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream stream { &file };
+    for (const auto& chunk : chunks) {
+        stream << (quint32)chunk.length;
+        stream.writeRawData(chunk.hash.constData(), chunk.hash.size());
+    }
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+void AssetChunkStore::addChunks(const AssetUtils::AssetHash& hash, const std::vector<AssetUtils::AssetChunk>& chunks) {
+    for (const auto& chunk : chunks) {
+        // a chunk held by several assets is read from the first one that was listed
+        if (!_chunks.contains(chunk.hash)) {
+            _chunks.insert(chunk.hash, { hash, chunk.offset, chunk.length });
+        }
+    }
+}
+
+void AssetChunkStore::removeChunks(const AssetUtils::AssetHash& hash, const std::vector<AssetUtils::AssetChunk>& chunks) {
+    for (const auto& chunk : chunks) {
+        auto it = _chunks.find(chunk.hash);
+        if (it != _chunks.end() && it.value().hash == hash) {
+            _chunks.erase(it);
+        }
+    }
+}
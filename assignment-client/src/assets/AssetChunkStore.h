@@ -0,0 +1,75 @@
+//
+//  AssetChunkStore.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkStore_h
+#define hifi_AssetChunkStore_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+#include "AssetUtils.h"
+
+class AssetStorage;
+
+/// Keeps the content-defined chunks of the asset files, so that clients can be told which chunks an asset is made of,
+/// and uploads can leave out the chunks the server already holds in another asset. The asset files themselves stay
+/// whole, the chunk list of each asset is kept in the chunks directory under the files directory.
+class AssetChunkStore {
+public:
+    static const QString CHUNKS_SUBDIR;
+
+    /// Load the chunk lists kept in the files directory of storage and start keeping new ones there. Until this is
+    /// called the store is disabled and holds nothing.
+    bool load(const AssetStorage& storage);
+    bool isEnabled() const { return _isEnabled; }
+
+    /// Returns the chunks of an asset, splitting its file the first time they are asked for. Returns an empty list if
+    /// the store is disabled or the file can't be read.
+    std::vector<AssetUtils::AssetChunk> getChunks(const AssetUtils::AssetHash& hash);
+
+    /// Returns, for each chunk hash, whether a stored asset holds that chunk.
+    std::vector<bool> findChunks(const std::vector<QByteArray>& chunkHashes) const;
+
+    /// Reads a chunk out of the asset that holds it. Returns a null QByteArray if no stored asset holds it anymore.
+    QByteArray readChunk(const QByteArray& chunkHash);
+
+    /// Forget the chunks of an asset whose file was deleted.
+    void remove(const AssetUtils::AssetHash& hash);
+
+    int getNumChunks() const;
+
+private:
+    struct ChunkLocation {
+        AssetUtils::AssetHash hash;
+        AssetUtils::DataOffset offset;
+        int64_t length;
+    };
+
+    QString getChunkListPath(const AssetUtils::AssetHash& hash) const;
+    std::vector<AssetUtils::AssetChunk> readChunkList(const AssetUtils::AssetHash& hash) const;
+    bool writeChunkList(const AssetUtils::AssetHash& hash, const std::vector<AssetUtils::AssetChunk>& chunks) const;
+    void addChunks(const AssetUtils::AssetHash& hash, const std::vector<AssetUtils::AssetChunk>& chunks); // with _mutex held
+    void removeChunks(const AssetUtils::AssetHash& hash, const std::vector<AssetUtils::AssetChunk>& chunks); // with _mutex held
+
+    const AssetStorage* _storage { nullptr };
+    QString _chunksPath; // a plain path, the lists are read and written from the transfer threads
+    std::atomic<bool> _isEnabled { false };
+
+    mutable std::mutex _mutex;
+    QHash<QByteArray, ChunkLocation> _chunks; // by chunk hash, guarded by _mutex
+};
+
+#endif // hifi_AssetChunkStore_h
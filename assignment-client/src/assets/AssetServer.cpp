@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -37,12 +38,14 @@
 
 #include "AssetServerLogging.h"
 #include "BakeAssetTask.h"
+#include "SendAssetChunksTask.h"
 #include "SendAssetTask.h"
 #include "UploadAssetTask.h"
 
 static const uint8_t MIN_CORES_FOR_MULTICORE = 4;
 static const uint8_t CPU_AFFINITY_COUNT_HIGH = 2;
 static const uint8_t CPU_AFFINITY_COUNT_LOW = 1;
+static const qint64 BYTES_PER_MEGABYTE = 1000 * 1000;
 #ifdef Q_OS_WIN
 static const int INTERFACE_RUNNING_CHECK_FREQUENCY_MS = 1000;
 #endif
@@ -109,6 +112,15 @@ BakeVersion currentBakeVersionForAssetType(BakedAssetType type) {
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
+// every oven process is multi-threaded itself, so by default bakes are only given a quarter of the cores
+static int defaultConcurrentBakes() {
+    static const int CORES_PER_BAKE = 4;
+    return std::max((int)std::thread::hardware_concurrency() / CORES_PER_BAKE, 1);
+}
+
+// bakes of assets that clients are asking for go ahead of the others
+static const int REQUESTED_BAKE_PRIORITY = 1;
+
 void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
@@ -127,8 +139,22 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
     }
 }
 
+void AssetServer::prioritizeBake(const AssetUtils::AssetHash& assetHash) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end() || _prioritizedBakes.contains(assetHash)) {
+        return;
+    }
+
+    // only a bake that is still queued can move, one that is running already is as early as it gets
+    _prioritizedBakes.insert(assetHash);
+    if (_bakingTaskPool.tryTake(it->get())) {
+        qDebug() << "Prioritizing bake of requested asset" << assetHash;
+        _bakingTaskPool.start(it->get(), REQUESTED_BAKE_PRIORITY);
+    }
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
-    return _filesDirectory.absoluteFilePath(assetHash);
+    return _storage->getFilePath(assetHash);
 }
 
 std::pair<AssetUtils::BakingStatus, QString> AssetServer::getAssetStatus(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
@@ -299,11 +325,14 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-    _bakingTaskPool.setMaxThreadCount(1);
+    _bakingTaskPool.setMaxThreadCount(defaultConcurrentBakes());
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation }, this, "queueRequests");
+    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload,
+                                              PacketType::AssetMappingOperation, PacketType::AssetGetChunks,
+                                              PacketType::AssetFindChunks, PacketType::AssetUploadChunks },
+                                            this, "queueRequests");
 
 #ifdef Q_OS_WIN
     updateConsumedCores();
@@ -419,17 +448,40 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    // get the number of bakes that can run at the same time
+    static const QString MAX_CONCURRENT_BAKES_OPTION = "max_concurrent_bakes";
+    auto maxConcurrentBakes = assetServerObject[MAX_CONCURRENT_BAKES_OPTION].toInt(0);
+    _bakingTaskPool.setMaxThreadCount(maxConcurrentBakes > 0 ? maxConcurrentBakes : defaultConcurrentBakes());
+    qCInfo(asset_server) << "Running up to" << _bakingTaskPool.maxThreadCount() << "bakes at a time.";
+
+    // pick where the asset files are kept, the files kept in the other layout are moved over
+    static const QString STORAGE_LAYOUT_OPTION = "assets_storage_layout";
+    auto storageLayout = assetServerObject[STORAGE_LAYOUT_OPTION].toString(AssetStorage::SHARDED_LAYOUT);
+    _storage = AssetStorage::create(storageLayout);
+    if (!_storage) {
+        qCWarning(asset_server) << "Unknown asset storage layout" << storageLayout << "- using" << AssetStorage::SHARDED_LAYOUT;
+        _storage = AssetStorage::create(AssetStorage::SHARDED_LAYOUT);
+    }
+    if (!_storage->load(_filesDirectory)) {
+        qCCritical(asset_server) << "Unable to move the asset files into the" << storageLayout << "layout. Stopping assignment.";
+        setFinished(true);
+        return;
+    }
+
+    // chunked transfers keep the chunk lists of the assets, so they can be turned off to save the space
+    static const QString CHUNKED_TRANSFERS_OPTION = "chunked_transfers";
+    if (assetServerObject[CHUNKED_TRANSFERS_OPTION].toBool(true)) {
+        _chunkStore.load(*_storage);
+    }
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
 
         // Check the asset directory to output some information about what we have
-        auto files = _filesDirectory.entryList(QDir::Files);
+        auto hashes = _storage->getHashes();
 
-        QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
-        auto hashedFiles = files.filter(hashFileRegex);
-
-        qCInfo(asset_server) << "There are" << hashedFiles.size() << "asset files in the asset directory.";
+        qCInfo(asset_server) << "There are" << hashes.size() << "asset files in the asset directory.";
 
         if (_fileMappings.size() > 0) {
             cleanupUnmappedFiles();
@@ -453,6 +505,13 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the in-memory cache of hot assets
+    static const QString ASSETS_CACHE_SIZE_OPTION = "assets_cache_size";
+    auto assetsCacheSizeJSONValue = assetServerObject[ASSETS_CACHE_SIZE_OPTION];
+    if (assetsCacheSizeJSONValue.isDouble()) {
+        _assetCache.setMaxSize(std::max(assetsCacheSizeJSONValue.toInt(), 0) * BYTES_PER_MEGABYTE);
+    }
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -461,8 +520,13 @@ void AssetServer::completeSetup() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AssetGet, this, "handleAssetGet");
     packetReceiver.registerListener(PacketType::AssetGetInfo, this, "handleAssetGetInfo");
-    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload");
+    // uploads are handed over as soon as they start arriving, UploadAssetTask writes them as they come in
+    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload", true);
     packetReceiver.registerListener(PacketType::AssetMappingOperation, this, "handleAssetMappingOperation");
+    packetReceiver.registerListener(PacketType::AssetGetChunks, this, "handleAssetGetChunks");
+    packetReceiver.registerListener(PacketType::AssetFindChunks, this, "handleAssetFindChunks");
+    // chunked uploads only carry what the server doesn't hold yet, so they are handed over once complete
+    packetReceiver.registerListener(PacketType::AssetUploadChunks, this, "handleAssetUpload");
 
     replayRequests();
 }
@@ -500,8 +564,15 @@ void AssetServer::replayRequests() {
                 handleAssetGetInfo(request.first, request.second);
                 break;
             case PacketType::AssetUpload:
+            case PacketType::AssetUploadChunks:
                 handleAssetUpload(request.first, request.second);
                 break;
+            case PacketType::AssetGetChunks:
+                handleAssetGetChunks(request.first, request.second);
+                break;
+            case PacketType::AssetFindChunks:
+                handleAssetFindChunks(request.first, request.second);
+                break;
             case PacketType::AssetMappingOperation:
                 handleAssetMappingOperation(request.first, request.second);
                 break;
@@ -512,37 +583,50 @@ void AssetServer::replayRequests() {
     }
 }
 
-void AssetServer::cleanupUnmappedFiles() {
-    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+QSet<AssetUtils::AssetHash> AssetServer::getMappedHashes() const {
+    QSet<AssetUtils::AssetHash> mappedHashes;
+    mappedHashes.reserve((int)_fileMappings.size());
+    for (const auto& pair : _fileMappings) {
+        mappedHashes.insert(pair.second);
+    }
+    return mappedHashes;
+}
 
-    auto files = _filesDirectory.entryInfoList(QDir::Files);
+void AssetServer::cleanupUnmappedFiles() {
+    // only the names are needed, the storage lists them without collecting the info of every file
+    auto hashes = _storage->getHashes();
+    auto mappedHashes = getMappedHashes();
 
     qCInfo(asset_server) << "Performing unmapped asset cleanup.";
 
-    for (const auto& fileInfo : files) {
-        auto filename = fileInfo.fileName();
-        if (hashFileRegex.exactMatch(filename)) {
-            bool matched { false };
-            for (auto& pair : _fileMappings) {
-                if (pair.second == filename) {
-                    matched = true;
-                    break;
-                }
-            }
-            if (!matched) {
-                // remove the unmapped file
-                QFile removeableFile { fileInfo.absoluteFilePath() };
+    // uploads that were still arriving when the server stopped
+    auto temporaryFiles = _filesDirectory.entryList({ UploadAssetTask::TEMPORARY_FILE_PREFIX + "*" }, QDir::Files);
+    for (const auto& filename : temporaryFiles) {
+        QFile::remove(_filesDirectory.absoluteFilePath(filename));
+    }
 
-                if (removeableFile.remove()) {
-                    qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
+    QSet<AssetUtils::AssetHash> deletedHashes;
 
-                    removeBakedPathsForDeletedAsset(filename);
-                } else {
-                    qCDebug(asset_server) << "\tAttempt to delete unmapped file" << filename << "failed";
-                }
+    for (const auto& hash : hashes) {
+        if (!mappedHashes.contains(hash)) {
+            // remove the unmapped file
+            QFile removeableFile { _storage->getFilePath(hash) };
+
+            if (removeableFile.remove()) {
+                qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is unmapped.";
+                _assetCache.remove(hash);
+                _chunkStore.remove(hash);
+
+                deletedHashes.insert(hash);
+            } else {
+                qCDebug(asset_server) << "\tAttempt to delete unmapped file" << hash << "failed";
             }
         }
     }
+
+    // the baked content of the deleted files is removed once they are all gone, deleteMappings
+    // removes the baked files that this leaves unmapped
+    removeBakedPathsForDeletedAssets(deletedHashes);
 }
 
 void AssetServer::cleanupBakedFilesForDeletedAssets() {
@@ -562,19 +646,19 @@ void AssetServer::cleanupBakedFilesForDeletedAssets() {
         }
     }
 
+    auto mappedHashes = getMappedHashes();
+    QSet<AssetUtils::AssetHash> deletedHashes;
+
     // enumerate the hashes for which we have baked content
     for (const auto& hash : bakedHashes) {
         // check if we have a mapping that points to this hash
-        auto matchingMapping = std::find_if(std::begin(_fileMappings), std::end(_fileMappings),
-                                            [&hash](const std::pair<AssetUtils::AssetPath, AssetUtils::AssetHash> mappingPair) {
-            return mappingPair.second == hash;
-        });
-
-        if (matchingMapping == std::end(_fileMappings)) {
+        if (!mappedHashes.contains(hash)) {
             // we didn't find a mapping for this hash, remove any baked content we still have for it
-            removeBakedPathsForDeletedAsset(hash);
+            deletedHashes.insert(hash);
         }
     }
+
+    removeBakedPathsForDeletedAssets(deletedHashes);
 }
 
 void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -663,6 +747,9 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
                 }
             } else {
                 qDebug() << "Did not find baked version for: " << originalAssetHash << assetPath;
+
+                // someone wants this asset now, bake it before the ones nobody has asked for
+                prioritizeBake(originalAssetHash);
             }
         }
 
@@ -847,7 +934,7 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
     replyPacket->write(assetHash);
 
     QString fileName = QString(hexHash);
-    QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
+    QFileInfo fileInfo { _storage->getFilePath(fileName) };
 
     if (fileInfo.exists() && fileInfo.isReadable()) {
         qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
@@ -872,10 +959,76 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _storage.get(), &_assetCache);
     _transferTaskPool.start(task);
 }
 
+void AssetServer::handleAssetGetChunks(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (message->getSize() < qint64(sizeof(MessageID) + AssetUtils::SHA256_HASH_LENGTH)) {
+        qCDebug(asset_server) << "ERROR bad chunks request";
+        return;
+    }
+
+    // listing the chunks of an asset the first time reads all of it
+    auto task = new SendAssetChunksTask(message, senderNode, _storage.get(), &_chunkStore);
+    _transferTaskPool.start(task);
+}
+
+void AssetServer::handleAssetFindChunks(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    MessageID messageID;
+    uint32_t numChunks;
+
+    if (message->getSize() < qint64(sizeof(messageID) + sizeof(numChunks))) {
+        qCDebug(asset_server) << "ERROR bad find chunks request";
+        return;
+    }
+
+    message->readPrimitive(&messageID);
+    message->readPrimitive(&numChunks);
+
+    auto replyPacket = NLPacketList::create(PacketType::AssetFindChunksReply, QByteArray(), true, true);
+    replyPacket->writePrimitive(messageID);
+
+    // which chunks are held is only told to those who could upload the asset
+    bool canWriteToAssetServer = !senderNode || senderNode->getCanWriteToAssetServer();
+
+    if (!canWriteToAssetServer) {
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+    } else if (!_chunkStore.isEnabled()) {
+        // the client uploads the whole asset instead
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+    } else if ((qint64)numChunks * (qint64)AssetUtils::SHA256_HASH_LENGTH > message->getBytesLeftToRead()) {
+        qCDebug(asset_server) << "ERROR find chunks request lists more chunks than it carries";
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+    } else {
+        std::vector<QByteArray> chunkHashes;
+        chunkHashes.reserve(numChunks);
+        for (uint32_t i = 0; i < numChunks; ++i) {
+            chunkHashes.push_back(message->read(AssetUtils::SHA256_HASH_LENGTH));
+        }
+
+        // one bit per chunk, set for the chunks the server holds
+        auto found = _chunkStore.findChunks(chunkHashes);
+        QByteArray foundBits((int)((numChunks + 7) / 8), '\0');
+        for (uint32_t i = 0; i < numChunks; ++i) {
+            if (found[i]) {
+                foundBits[i / 8] = (char)(foundBits.at(i / 8) | (1 << (i % 8)));
+            }
+        }
+
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacket->writePrimitive(numChunks);
+        replyPacket->write(foundBits);
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (senderNode) {
+        nodeList->sendPacketList(std::move(replyPacket), *senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacket), message->getSenderSockAddr());
+    }
+}
+
 void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     bool canWriteToAssetServer = true;
     if (senderNode) {
@@ -886,8 +1039,9 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
-        _transferTaskPool.start(task);
+        auto task = QSharedPointer<UploadAssetTask>::create(message, senderNode, _storage.get(), _filesizeLimit,
+                                                            &_transferTaskPool, &_assetCache, &_chunkStore);
+        task->start();
     } else {
         // this is a node the domain told us is not allowed to rez entities
         // for now this also means it isn't allowed to add assets
@@ -895,8 +1049,9 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
 
         auto permissionErrorPacket = NLPacket::create(PacketType::AssetUploadReply, sizeof(MessageID) + sizeof(AssetUtils::AssetServerError), true);
 
+        // the rest of the upload may still be arriving
         MessageID messageID;
-        message->readPrimitive(&messageID);
+        message->readHeadPrimitive(&messageID);
 
         // write the message ID and a permission denied error
         permissionErrorPacket->writePrimitive(messageID);
@@ -969,6 +1124,17 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     }
 
+    QJsonObject cacheStats;
+    auto numHits = _assetCache.getNumHits();
+    auto numRequests = numHits + _assetCache.getNumMisses() + _assetCache.getNumCoalescedMisses();
+    cacheStats["1. Assets"] = _assetCache.getNumAssets();
+    cacheStats["2. Size (MB)"] = (double)_assetCache.getSize() / BYTES_PER_MEGABYTE;
+    cacheStats["3. Hit Rate (%)"] = numRequests == 0 ? 0.0 : 100.0 * numHits / numRequests;
+    cacheStats["4. Coalesced Misses"] = (double)_assetCache.getNumCoalescedMisses();
+    cacheStats["5. Served from Memory (MB)"] = (double)_assetCache.getBytesServed() / BYTES_PER_MEGABYTE;
+    serverStats["Asset Cache"] = cacheStats;
+    serverStats["Stored Chunks"] = _chunkStore.getNumChunks();
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1063,43 +1229,61 @@ bool AssetServer::writeMappingsToFile() {
 }
 
 bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash) {
-    path = path.trimmed();
+    return setMappings({ { path, hash } });
+}
 
-    if (!AssetUtils::isValidFilePath(path)) {
-        qCWarning(asset_server) << "Cannot set a mapping for invalid path:" << path << "=>" << hash;
-        return false;
-    }
+bool AssetServer::setMappings(const AssetUtils::Mappings& mappings) {
+    AssetUtils::Mappings newMappings;
 
-    if (!AssetUtils::isValidHash(hash)) {
-        qCWarning(asset_server) << "Cannot set a mapping for invalid hash" << path << "=>" << hash;
-        return false;
-    }
+    for (const auto& mapping : mappings) {
+        auto path = mapping.first.trimmed();
+        const auto& hash = mapping.second;
 
-    // remember what the old mapping was in case persistence fails
-    auto it = _fileMappings.find(path);
-    auto oldMapping = it != _fileMappings.end() ? it->second : "";
+        if (!AssetUtils::isValidFilePath(path)) {
+            qCWarning(asset_server) << "Cannot set a mapping for invalid path:" << path << "=>" << hash;
+            return false;
+        }
 
-    // update the in memory QHash
-    _fileMappings[path] = hash;
+        if (!AssetUtils::isValidHash(hash)) {
+            qCWarning(asset_server) << "Cannot set a mapping for invalid hash" << path << "=>" << hash;
+            return false;
+        }
 
-    // attempt to write to file
-    if (writeMappingsToFile()) {
-        // persistence succeeded, we are good to go
-        qCDebug(asset_server) << "Set mapping:" << path << "=>" << hash;
-        maybeBake(path, hash);
-        return true;
-    } else {
-        // failed to persist this mapping to file - put back the old one in our in-memory representation
-        if (oldMapping.isEmpty()) {
-            _fileMappings.erase(_fileMappings.find(path));
-        } else {
-            _fileMappings[path] = oldMapping;
+        newMappings[path] = hash;
+    }
+
+    // remember what the old mappings were in case persistence fails, and update the in memory map
+    AssetUtils::Mappings oldMappings;
+    for (const auto& mapping : newMappings) {
+        auto it = _fileMappings.find(mapping.first);
+        if (it == _fileMappings.end() || it->second != mapping.second) {
+            oldMappings[mapping.first] = it != _fileMappings.end() ? it->second : "";
+            _fileMappings[mapping.first] = mapping.second;
         }
+    }
 
-        qCWarning(asset_server) << "Failed to persist mapping:" << path << "=>" << hash;
+    // the mapping file is rewritten as a whole, so it is only written when something changed
+    if (!oldMappings.empty() && !writeMappingsToFile()) {
+        // failed to persist these mappings to file - put back the old ones in our in-memory representation
+        for (const auto& oldMapping : oldMappings) {
+            if (oldMapping.second.isEmpty()) {
+                _fileMappings.erase(oldMapping.first);
+            } else {
+                _fileMappings[oldMapping.first] = oldMapping.second;
+            }
+
+            qCWarning(asset_server) << "Failed to persist mapping:" << oldMapping.first << "=>" << newMappings[oldMapping.first];
+        }
 
         return false;
     }
+
+    // persistence succeeded, we are good to go
+    for (const auto& mapping : newMappings) {
+        qCDebug(asset_server) << "Set mapping:" << mapping.first << "=>" << mapping.second;
+        maybeBake(mapping.first, mapping.second);
+    }
+    return true;
 }
 
 bool pathIsFolder(const AssetUtils::AssetPath& path) {
@@ -1118,6 +1302,29 @@ void AssetServer::removeBakedPathsForDeletedAsset(AssetUtils::AssetHash hash) {
     deleteMappings(hiddenBakedFolder);
 }
 
+void AssetServer::removeBakedPathsForDeletedAssets(const QSet<AssetUtils::AssetHash>& hashes) {
+    if (hashes.isEmpty()) {
+        return;
+    }
+
+    // collect the baked mappings of all the deleted files in one pass, so they are deleted with a single write
+    AssetUtils::AssetPathList bakedPaths;
+    for (const auto& pair : _fileMappings) {
+        if (pair.first.startsWith(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER)) {
+            AssetUtils::AssetHash hash = pair.first.mid(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER.length(),
+                                                        AssetUtils::SHA256_HASH_HEX_LENGTH);
+            if (hashes.contains(hash)) {
+                bakedPaths << pair.first;
+            }
+        }
+    }
+
+    if (!bakedPaths.isEmpty()) {
+        qCDebug(asset_server) << "Deleting" << bakedPaths.size() << "baked mappings since" << hashes.size() << "assets were deleted";
+        deleteMappings(bakedPaths);
+    }
+}
+
 bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
     // take a copy of the current mappings in case persistence of these deletes fails
     auto oldMappings = _fileMappings;
@@ -1180,19 +1387,24 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         }
 
         // we now have a set of hashes that are unmapped - we will delete those asset files
+        QSet<AssetUtils::AssetHash> deletedHashes;
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
-            QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
+            QFile removeableFile { _storage->getFilePath(hash) };
 
             if (removeableFile.remove()) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
+                _assetCache.remove(hash);
+                _chunkStore.remove(hash);
 
-                removeBakedPathsForDeletedAsset(hash);
+                deletedHashes.insert(hash);
             } else {
                 qCDebug(asset_server) << "\tAttempt to delete unmapped file" << hash << "failed";
             }
         }
 
+        removeBakedPathsForDeletedAssets(deletedHashes);
+
         return true;
     } else {
         qCWarning(asset_server) << "Failed to persist deleted mappings, rolling back";
@@ -1330,6 +1542,7 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
     writeMetaFile(originalAssetHash, meta);
 
     _pendingBakes.remove(originalAssetHash);
+    _prioritizedBakes.remove(originalAssetHash);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1339,6 +1552,8 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
     qDebug() << "Completing bake for " << originalAssetHash;
 
+    AssetUtils::Mappings bakeMappings;
+
     for (auto& filePath : bakedFilePaths) {
         // figure out the hash for the contents of this file
         QFile file(filePath);
@@ -1360,10 +1575,11 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
             }
 
             // first check that we don't already have this bake file in our list
-            auto bakeFileDestination = _filesDirectory.absoluteFilePath(bakedFileHash);
+            auto bakeFileDestination = _storage->getFilePath(bakedFileHash);
             if (!QFile::exists(bakeFileDestination)) {
                 // copy each to our files folder (with the hash as their filename)
-                if (!file.copy(_filesDirectory.absoluteFilePath(bakedFileHash))) {
+                bakeFileDestination = _storage->createFilePath(bakedFileHash);
+                if (bakeFileDestination.isEmpty() || !file.copy(bakeFileDestination)) {
                     // stop handling this bake, couldn't copy the bake file into our files directory
                     errorCompletingBake = true;
                     errorReason = "Failed to copy baked assets to asset server";
@@ -1386,16 +1602,8 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
             QString bakeMapping = getBakeMapping(originalAssetHash, relativeFilePath);
 
-            // add a mapping (under the hidden baked folder) for this file resulting from the bake
-            if (setMapping(bakeMapping, bakedFileHash)) {
-                qDebug() << "Added" << bakeMapping << "for bake file" << bakedFileHash << "from bake of" << originalAssetHash;
-            } else {
-                qDebug() << "Failed to set mapping";
-                // stop handling this bake, couldn't add a mapping for this bake file
-                errorCompletingBake = true;
-                errorReason = "Failed to finalize bake";
-                break;
-            }
+            // a mapping (under the hidden baked folder) for this file resulting from the bake, added with the others below
+            bakeMappings[bakeMapping] = bakedFileHash;
         } else {
             qDebug() << "Failed to open baked file: " << filePath;
             // stop handling this bake, we couldn't open one of the files for reading
@@ -1405,6 +1613,17 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
         }
     }
 
+    // add the mappings for all the bake files at once, so the mapping file is written once per bake
+    if (!errorCompletingBake) {
+        if (setMappings(bakeMappings)) {
+            qDebug() << "Added" << bakeMappings.size() << "mappings for bake files from bake of" << originalAssetHash;
+        } else {
+            qDebug() << "Failed to set mappings";
+            errorCompletingBake = true;
+            errorReason = "Failed to finalize bake";
+        }
+    }
+
     for (auto& filePath : bakedFilePaths) {
         QFile file(filePath);
         if (!file.remove()) {
@@ -1430,6 +1649,7 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
     writeMetaFile(originalAssetHash, meta);
 
     _pendingBakes.remove(originalAssetHash);
+    _prioritizedBakes.remove(originalAssetHash);
 }
 
 void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath) {
@@ -1437,6 +1657,7 @@ void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath
 
     // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes
     _pendingBakes.remove(originalAssetHash);
+    _prioritizedBakes.remove(originalAssetHash);
 }
 
 static const QString BAKE_VERSION_KEY = "bake_version";
@@ -1453,7 +1674,7 @@ std::pair<bool, AssetMeta> AssetServer::readMetaFile(AssetUtils::AssetHash hash)
 
     auto metaFileHash = it->second;
 
-    QFile metaFile(_filesDirectory.absoluteFilePath(metaFileHash));
+    QFile metaFile(_storage->getFilePath(metaFileHash));
 
     if (metaFile.open(QIODevice::ReadOnly)) {
         auto data = metaFile.readAll();
@@ -1505,7 +1726,7 @@ bool AssetServer::writeMetaFile(AssetUtils::AssetHash originalAssetHash, const A
     AssetUtils::AssetHash metaFileHash = QCryptographicHash::hash(metaFileJSON, QCryptographicHash::Sha256).toHex();
 
     // create the meta file in our files folder, named by the hash of its contents
-    QFile metaFile(_filesDirectory.absoluteFilePath(metaFileHash));
+    QFile metaFile(_storage->createFilePath(metaFileHash));
 
     if (metaFile.open(QIODevice::WriteOnly)) {
         metaFile.write(metaFileJSON);
@@ -13,11 +13,15 @@
 #define hifi_AssetServer_h
 
 #include <QtCore/QDir>
+#include <QtCore/QSet>
 #include <QtCore/QThreadPool>
 #include <QRunnable>
 
 #include <ThreadedAssignment.h>
 
+#include "AssetCache.h"
+#include "AssetChunkStore.h"
+#include "AssetStorage.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -88,6 +92,8 @@ private slots:
     void queueRequests(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGetInfo(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGet(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
+    void handleAssetGetChunks(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
+    void handleAssetFindChunks(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUpload(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
     void handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
@@ -113,6 +119,9 @@ private:
     /// Set the mapping for path to hash
     bool setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash);
 
+    /// Set several mappings with a single write of the mapping file. Either all of them are set, or none.
+    bool setMappings(const AssetUtils::Mappings& mappings);
+
     /// Delete mapping `path`. Returns `true` if deletion of mappings succeeds, else `false`.
     bool deleteMappings(const AssetUtils::AssetPathList& paths);
 
@@ -121,6 +130,9 @@ private:
 
     bool setBakingEnabled(const AssetUtils::AssetPathList& paths, bool enabled);
 
+    /// Returns the set of hashes that are mapped to, to check many files against
+    QSet<AssetUtils::AssetHash> getMappedHashes() const;
+
     /// Delete any unmapped files from the local asset directory
     void cleanupUnmappedFiles();
 
@@ -138,6 +150,9 @@ private:
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    /// Move the queued bake of an asset that a client asked for ahead of the others
+    void prioritizeBake(const AssetUtils::AssetHash& assetHash);
+
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir,
                              QVector<QString> bakedFilePaths);
@@ -151,15 +166,28 @@ private:
     /// Remove baked paths when the original asset is deleteds
     void removeBakedPathsForDeletedAsset(AssetUtils::AssetHash originalAssetHash);
 
+    /// Delete the baked content of several deleted files with a single write of the mapping file
+    void removeBakedPathsForDeletedAssets(const QSet<AssetUtils::AssetHash>& hashes);
+
     AssetUtils::Mappings _fileMappings;
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// Where the file of each asset is kept under the files directory
+    std::unique_ptr<AssetStorage> _storage;
+
+    /// Hot assets, shared by the send tasks
+    AssetCache _assetCache;
+
+    /// Chunks of the stored assets, for chunked downloads and uploads
+    AssetChunkStore _chunkStore;
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
+    QSet<AssetUtils::AssetHash> _prioritizedBakes;
     QThreadPool _bakingTaskPool;
 
     QMutex _queuedRequestsMutex;
@@ -0,0 +1,50 @@
+//
+//  AssetStorage.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetStorage.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include "AssetServerLogging.h"
+#include "FlatAssetStorage.h"
+#include "ShardedAssetStorage.h"
+
+const QString AssetStorage::FLAT_LAYOUT = "flat";
+const QString AssetStorage::SHARDED_LAYOUT = "sharded";
+
+std::unique_ptr<AssetStorage> AssetStorage::create(const QString& layout) {
+    if (layout == FLAT_LAYOUT) {
+        return std::unique_ptr<AssetStorage>(new FlatAssetStorage());
+    } else if (layout == SHARDED_LAYOUT) {
+        return std::unique_ptr<AssetStorage>(new ShardedAssetStorage());
+    }
+    return nullptr;
+}
+
+bool AssetStorage::load(const QDir& filesDirectory) {
+    _filesPath = filesDirectory.absolutePath();
+    return migrate();
+}
+
+bool AssetStorage::moveFile(const QString& sourcePath, const QString& destinationPath) {
+    if (QFileInfo(destinationPath).isFile()) {
+        // both hold the asset with the same hash, uploads verify the one that is kept before trusting it
+        qCDebug(asset_server) << "Dropping" << sourcePath << "since" << destinationPath << "already exists";
+        return QFile::remove(sourcePath);
+    }
+
+    if (!QFile::rename(sourcePath, destinationPath)) {
+        qCWarning(asset_server) << "Failed to move" << sourcePath << "to" << destinationPath;
+        return false;
+    }
+    return true;
+}
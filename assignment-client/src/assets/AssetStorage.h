@@ -0,0 +1,62 @@
+//
+//  AssetStorage.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetStorage_h
+#define hifi_AssetStorage_h
+
+#include <memory>
+
+#include <QtCore/QDir>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "AssetUtils.h"
+
+/// Decides where the file of each asset is kept under the files directory of the asset server. Each asset is kept
+/// whole in a file of its own, since assets are sent from a memory map of their file and baked straight from it.
+class AssetStorage {
+public:
+    static const QString FLAT_LAYOUT;
+    static const QString SHARDED_LAYOUT;
+
+    /// Returns the storage for a layout name, or nullptr if the name is unknown.
+    static std::unique_ptr<AssetStorage> create(const QString& layout);
+
+    virtual ~AssetStorage() = default;
+
+    /// Start keeping the asset files under filesDirectory. Files kept there in another layout are moved into this one,
+    /// returns false if any of them couldn't be, since they would not be found.
+    bool load(const QDir& filesDirectory);
+
+    /// The paths are built from a copy of the directory path, so they can be asked for from any thread.
+    QDir getFilesDirectory() const { return QDir(_filesPath); }
+
+    /// Returns the path of the file that holds an asset, whether or not it exists.
+    virtual QString getFilePath(const AssetUtils::AssetHash& hash) const = 0;
+
+    /// Returns the path of the file that holds an asset, creating the directory it goes in, so that a file can be
+    /// moved or copied there. Returns an empty string if the directory can't be created.
+    virtual QString createFilePath(const AssetUtils::AssetHash& hash) const = 0;
+
+    /// Returns the hashes of all the stored assets.
+    virtual QStringList getHashes() const = 0;
+
+protected:
+    /// Move the files kept under the files directory in another layout into this one. Returns false if any is left.
+    virtual bool migrate() = 0;
+
+    /// Move an asset file from one layout to another. A file that is already at the destination is kept.
+    static bool moveFile(const QString& sourcePath, const QString& destinationPath);
+
+    QString _filesPath;
+};
+
+#endif // hifi_AssetStorage_h
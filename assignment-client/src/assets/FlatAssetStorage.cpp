@@ -0,0 +1,70 @@
+//
+//  FlatAssetStorage.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FlatAssetStorage.h"
+
+#include "AssetServerLogging.h"
+#include "ShardedAssetStorage.h"
+
+QString FlatAssetStorage::getFilePath(const AssetUtils::AssetHash& hash) const {
+    return _filesPath + "/" + hash;
+}
+
+QString FlatAssetStorage::createFilePath(const AssetUtils::AssetHash& hash) const {
+    return getFilePath(hash);
+}
+
+QStringList FlatAssetStorage::getHashes() const {
+    QStringList hashes;
+    for (const auto& filename : getFilesDirectory().entryList(QDir::Files)) {
+        if (AssetUtils::isValidHash(filename)) {
+            hashes << filename;
+        }
+    }
+    return hashes;
+}
+
+bool FlatAssetStorage::migrate() {
+    auto filesDirectory = getFilesDirectory();
+
+    // move the files of a sharded layout back up, and drop the shards once they are empty
+    int numMovedFiles = 0;
+    int numFailedFiles = 0;
+    for (const auto& shardName : filesDirectory.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (!ShardedAssetStorage::isShardName(shardName)) {
+            continue;
+        }
+
+        QDir shardDirectory { filesDirectory.filePath(shardName) };
+        for (const auto& hash : shardDirectory.entryList(QDir::Files)) {
+            if (!AssetUtils::isValidHash(hash)) {
+                continue;
+            }
+            if (moveFile(shardDirectory.filePath(hash), getFilePath(hash))) {
+                ++numMovedFiles;
+            } else {
+                ++numFailedFiles;
+            }
+        }
+        filesDirectory.rmdir(shardName);
+    }
+
+    if (numMovedFiles > 0) {
+        qCInfo(asset_server) << "Moved" << numMovedFiles << "asset files out of the sharded layout.";
+    }
+
+    // the files left in their shards can't be found in this layout
+    if (numFailedFiles > 0) {
+        qCCritical(asset_server) << "Failed to move" << numFailedFiles << "asset files out of the sharded layout.";
+        return false;
+    }
+    return true;
+}
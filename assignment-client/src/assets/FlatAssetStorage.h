@@ -0,0 +1,29 @@
+//
+//  FlatAssetStorage.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FlatAssetStorage_h
+#define hifi_FlatAssetStorage_h
+
+#include "AssetStorage.h"
+
+/// Keeps every asset file directly in the files directory, named by its hash. This is the layout of older asset
+/// servers, loading it moves the files of a sharded layout back up.
+class FlatAssetStorage : public AssetStorage {
+public:
+    QString getFilePath(const AssetUtils::AssetHash& hash) const override;
+    QString createFilePath(const AssetUtils::AssetHash& hash) const override;
+    QStringList getHashes() const override;
+
+protected:
+    bool migrate() override;
+};
+
+#endif // hifi_FlatAssetStorage_h
@@ -0,0 +1,76 @@
+//
+//  SendAssetChunksTask.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendAssetChunksTask.h"
+
+#include <QtCore/QFileInfo>
+
+#include <DependencyManager.h>
+#include <NLPacketList.h>
+#include <NodeList.h>
+
+#include "AssetChunkStore.h"
+#include "AssetServerLogging.h"
+#include "AssetStorage.h"
+#include "AssetUtils.h"
+#include "ClientServerUtils.h"
+
+SendAssetChunksTask::SendAssetChunksTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                                         const AssetStorage* storage, AssetChunkStore* chunkStore) :
+    QRunnable(),
+    _message(message),
+    _senderNode(sendToNode),
+    _storage(storage),
+    _chunkStore(chunkStore)
+{
+
+}
+
+void SendAssetChunksTask::run() {
+    MessageID messageID;
+    _message->readPrimitive(&messageID);
+    QByteArray assetHash = _message->read(AssetUtils::SHA256_HASH_LENGTH);
+    QString hexHash = assetHash.toHex();
+
+    auto replyPacketList = NLPacketList::create(PacketType::AssetGetChunksReply, QByteArray(), true, true);
+    replyPacketList->writePrimitive(messageID);
+    replyPacketList->write(assetHash);
+
+    QFileInfo fileInfo { _storage->getFilePath(hexHash) };
+    if (!fileInfo.exists()) {
+        qCDebug(asset_server) << "Asset not found: " << hexHash;
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+    } else if (!_chunkStore->isEnabled()) {
+        // the client gets the asset in parts instead
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+    } else {
+        auto chunks = _chunkStore->getChunks(hexHash);
+        if (chunks.empty() && fileInfo.size() > 0) {
+            qCWarning(asset_server) << "Failed to list the chunks of" << hexHash;
+            replyPacketList->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+        } else {
+            // the offsets of the chunks follow from their lengths
+            replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+            replyPacketList->writePrimitive((uint32_t)chunks.size());
+            for (const auto& chunk : chunks) {
+                replyPacketList->writePrimitive((uint32_t)chunk.length);
+                replyPacketList->write(chunk.hash);
+            }
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (_senderNode) {
+        nodeList->sendPacketList(std::move(replyPacketList), *_senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacketList), _message->getSenderSockAddr());
+    }
+}
@@ -0,0 +1,39 @@
+//
+//  SendAssetChunksTask.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendAssetChunksTask_h
+#define hifi_SendAssetChunksTask_h
+
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+
+#include "Node.h"
+#include "ReceivedMessage.h"
+
+class AssetChunkStore;
+class AssetStorage;
+
+/// Sends the list of chunks an asset is made of, splitting the asset first if it was never asked for before.
+class SendAssetChunksTask : public QRunnable {
+public:
+    SendAssetChunksTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                        const AssetStorage* storage, AssetChunkStore* chunkStore);
+
+    void run() override;
+
+private:
+    QSharedPointer<ReceivedMessage> _message;
+    SharedNodePointer _senderNode;
+    const AssetStorage* _storage;
+    AssetChunkStore* _chunkStore;
+};
+
+#endif // hifi_SendAssetChunksTask_h
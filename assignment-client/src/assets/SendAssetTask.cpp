@@ -22,15 +22,19 @@
 #include <NodeList.h>
 #include <udt/Packet.h>
 
+#include "AssetCache.h"
+#include "AssetStorage.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                             const AssetStorage* storage, AssetCache* assetCache) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _storage(storage),
+    _assetCache(assetCache)
 {
     
 }
@@ -63,18 +67,21 @@ void SendAssetTask::run() {
     if (!byteRange.isValid()) {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
     } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
+        QString filePath = _storage->getFilePath(hexHash);
+
+        // hot assets are served from memory, the others straight from their file
+        QByteArray cachedData = _assetCache ? _assetCache->get(hexHash, filePath) : QByteArray();
         QFile file { filePath };
 
-        if (file.open(QIODevice::ReadOnly)) {
+        if (!cachedData.isNull() || file.open(QIODevice::ReadOnly)) {
+            qint64 fileSize = cachedData.isNull() ? file.size() : cachedData.size();
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(fileSize);
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,24 +89,27 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
+                // a positive range starts that far into the file, a negative one that far back from its end
+                qint64 offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive
+                                                             : fileSize + byteRange.fromInclusive;
 
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+                replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList->writePrimitive(size);
 
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
+                if (!cachedData.isNull()) {
+                    replyPacketList->write(cachedData.constData() + offset, size);
+                    _assetCache->countBytesServed(size);
+                } else {
+                    // map the range rather than reading it into a buffer of its own, so the packets are written
+                    // straight from the page cache, and unmap it as soon as they hold the data
+                    uchar* mappedData = size > 0 ? file.map(offset, size) : nullptr;
+                    if (mappedData) {
+                        replyPacketList->write(reinterpret_cast<const char*>(mappedData), size);
+                        file.unmap(mappedData);
+                    } else if (size > 0) {
+                        file.seek(offset);
+                        replyPacketList->write(file.read(size));
+                    }
                 }
 
                 qCDebug(networking) << "Sending asset: " << hexHash;
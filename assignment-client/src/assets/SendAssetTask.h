@@ -21,18 +21,22 @@
 #include "AssetServer.h"
 #include "Node.h"
 
+class AssetCache;
+class AssetStorage;
 class NLPacket;
 
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                  const AssetStorage* storage, AssetCache* assetCache = nullptr);
 
     void run() override;
 
 private:
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
-    QDir _resourcesDir;
+    const AssetStorage* _storage;
+    AssetCache* _assetCache;
 };
 
 #endif
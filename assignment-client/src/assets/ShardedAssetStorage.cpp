@@ -0,0 +1,93 @@
+//
+//  ShardedAssetStorage.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShardedAssetStorage.h"
+
+#include <QtCore/QRegExp>
+
+#include "AssetServerLogging.h"
+
+// two hex characters make 256 shards, a few hundred thousand assets leave around a thousand files in each
+const int ShardedAssetStorage::SHARD_PREFIX_LENGTH = 2;
+
+bool ShardedAssetStorage::isShardName(const QString& name) {
+    QRegExp shardNameRegex { QString("^[a-f0-9]{%1}$").arg(SHARD_PREFIX_LENGTH) };
+    return shardNameRegex.exactMatch(name);
+}
+
+QString ShardedAssetStorage::getFilePath(const AssetUtils::AssetHash& hash) const {
+    return _filesPath + "/" + getShardName(hash) + "/" + hash;
+}
+
+QString ShardedAssetStorage::createFilePath(const AssetUtils::AssetHash& hash) const {
+    if (!getFilesDirectory().mkpath(getShardName(hash))) {
+        return QString();
+    }
+    return getFilePath(hash);
+}
+
+QStringList ShardedAssetStorage::getHashes() const {
+    auto filesDirectory = getFilesDirectory();
+
+    QStringList hashes;
+    for (const auto& shardName : filesDirectory.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (!isShardName(shardName)) {
+            continue;
+        }
+
+        QDir shardDirectory { filesDirectory.filePath(shardName) };
+        for (const auto& filename : shardDirectory.entryList(QDir::Files)) {
+            if (AssetUtils::isValidHash(filename) && getShardName(filename) == shardName) {
+                hashes << filename;
+            }
+        }
+    }
+    return hashes;
+}
+
+bool ShardedAssetStorage::migrate() {
+    auto filesDirectory = getFilesDirectory();
+
+    // move the files of the flat layout into their shards
+    int numMovedFiles = 0;
+    int numFailedFiles = 0;
+    for (const auto& hash : filesDirectory.entryList(QDir::Files)) {
+        if (!AssetUtils::isValidHash(hash)) {
+            continue;
+        }
+
+        auto filePath = createFilePath(hash);
+        if (filePath.isEmpty()) {
+            qCCritical(asset_server) << "Unable to create the shard for" << hash;
+            return false;
+        }
+        if (moveFile(filesDirectory.filePath(hash), filePath)) {
+            ++numMovedFiles;
+        } else {
+            ++numFailedFiles;
+        }
+    }
+
+    if (numMovedFiles > 0) {
+        qCInfo(asset_server) << "Moved" << numMovedFiles << "asset files into the sharded layout.";
+    }
+
+    // the files left in the flat layout can't be found in this one
+    if (numFailedFiles > 0) {
+        qCCritical(asset_server) << "Failed to move" << numFailedFiles << "asset files into the sharded layout.";
+        return false;
+    }
+    return true;
+}
+
+QString ShardedAssetStorage::getShardName(const AssetUtils::AssetHash& hash) const {
+    return hash.left(SHARD_PREFIX_LENGTH).toLower();
+}
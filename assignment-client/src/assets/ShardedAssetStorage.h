@@ -0,0 +1,37 @@
+//
+//  ShardedAssetStorage.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShardedAssetStorage_h
+#define hifi_ShardedAssetStorage_h
+
+#include "AssetStorage.h"
+
+/// Keeps each asset file in a subdirectory named by the first characters of its hash, so that no directory holds more
+/// than a fraction of the assets. Loading it moves the files of the flat layout into their subdirectories.
+class ShardedAssetStorage : public AssetStorage {
+public:
+    static const int SHARD_PREFIX_LENGTH;
+
+    /// Returns whether a directory name is the name of a shard.
+    static bool isShardName(const QString& name);
+
+    QString getFilePath(const AssetUtils::AssetHash& hash) const override;
+    QString createFilePath(const AssetUtils::AssetHash& hash) const override;
+    QStringList getHashes() const override;
+
+protected:
+    bool migrate() override;
+
+private:
+    QString getShardName(const AssetUtils::AssetHash& hash) const;
+};
+
+#endif // hifi_ShardedAssetStorage_h
@@ -11,103 +11,240 @@
 
 #include "UploadAssetTask.h"
 
-#include <QtCore/QBuffer>
-#include <QtCore/QFile>
+#include <limits>
+#include <vector>
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
 
 #include <AssetUtils.h>
 #include <NodeList.h>
 #include <NLPacketList.h>
 
-#include "ClientServerUtils.h"
+#include "AssetCache.h"
+#include "AssetChunkStore.h"
+#include "AssetStorage.h"
+
+// one run of an upload on the task pool, it holds on to the upload until it is done
+class UploadAssetRunnable : public QRunnable {
+public:
+    UploadAssetRunnable(QSharedPointer<UploadAssetTask> task) : _task(task) {}
+
+    void run() override { _task->run(); }
+
+private:
+    QSharedPointer<UploadAssetTask> _task;
+};
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const AssetStorage* storage, uint64_t filesizeLimit, QThreadPool* taskPool,
+                                 AssetCache* assetCache, AssetChunkStore* chunkStore) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
-    _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _storage(storage),
+    _filesizeLimit(filesizeLimit),
+    _taskPool(taskPool),
+    _assetCache(assetCache),
+    _chunkStore(chunkStore)
 {
     
 }
 
+const QString UploadAssetTask::TEMPORARY_FILE_PREFIX = "upload-";
+
+void UploadAssetTask::start() {
+    auto self = sharedFromThis();
+
+    // the signals are sent from the thread the packets arrive on, they only hand the new data to the task pool
+    _progressConnection = QObject::connect(_receivedMessage.data(), &ReceivedMessage::progress, [self] {
+        self->scheduleRun();
+    });
+    _completedConnection = QObject::connect(_receivedMessage.data(), &ReceivedMessage::completed, [self] {
+        self->scheduleRun();
+    });
+
+    // the message may have completed before we connected
+    scheduleRun();
+}
+
+void UploadAssetTask::scheduleRun() {
+    // a run that is already going picks up whatever arrived since it started, so runs never overlap
+    if (_numPendingRuns++ == 0) {
+        _taskPool->start(new UploadAssetRunnable(sharedFromThis()));
+    }
+}
+
 void UploadAssetTask::run() {
-    auto data = _receivedMessage->getMessage();
-    
-    QBuffer buffer { &data };
-    buffer.open(QIODevice::ReadOnly);
-    
-    MessageID messageID;
-    buffer.read(reinterpret_cast<char*>(&messageID), sizeof(messageID));
-    
-    uint64_t fileSize;
-    buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+    do {
+        receiveAvailable();
+    } while (--_numPendingRuns > 0);
+}
 
-    if (_senderNode) {
-        qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
+void UploadAssetTask::receiveAvailable() {
+    if (_isDone) {
+        return;
+    }
+
+    if (!_isHeaderRead) {
+        // the message may still be arriving, only its head is safe to read until it is complete
+        _receivedMessage->readHeadPrimitive(&_messageID);
+        _receivedMessage->readHeadPrimitive(&_fileSize);
+        _isHeaderRead = true;
+
+        if (_senderNode) {
+            qDebug() << "UploadAssetTask reading a file of " << _fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
+        } else {
+            qDebug() << "UploadAssetTask reading a file of " << _fileSize << "bytes from" << _receivedMessage->getSenderSockAddr();
+        }
+
+        if (_fileSize > _filesizeLimit) {
+            auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
+            replyPacket->writePrimitive(_messageID);
+            replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+            sendReply(std::move(replyPacket));
+        } else {
+            // the data is hashed and written to a temporary file as it arrives, the file is moved in place under
+            // its hash once the upload is complete, so a partially written asset is never sent to anyone
+            _file.setFileTemplate(_storage->getFilesDirectory().filePath(TEMPORARY_FILE_PREFIX + "XXXXXX"));
+            _writeFailed = !_file.open();
+        }
+    }
+
+    if (_receivedMessage->getType() == PacketType::AssetUploadChunks) {
+        // chunked uploads are only handed over once complete, they leave out what the server already holds
+        finish();
+        return;
+    }
+
+    // anything appended after this is picked up by the run its signal schedules
+    bool isComplete = _receivedMessage->isComplete();
+
+    // the data is released from the message as it is taken, so an upload never sits in memory whole
+    if (_hasReplied || _writeFailed) {
+        _receivedMessage->takeReceived(std::numeric_limits<qint64>::max());
     } else {
-        qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << _receivedMessage->getSenderSockAddr();
+        auto data = _receivedMessage->takeReceived(_fileSize - _bytesReceived);
+        _hash.addData(data);
+        _writeFailed = _file.write(data) != data.size();
+        _bytesReceived += data.size();
     }
-    
+
+    if (!isComplete) {
+        return;
+    }
+
+    if (_receivedMessage->failed()) {
+        // the sender is gone, there is nobody to reply to
+        qWarning() << "Upload of" << _fileSize << "bytes failed after" << _bytesReceived << "bytes were received.";
+        stopReceiving();
+        return;
+    }
+
+    finish();
+}
+
+void UploadAssetTask::finish() {
+    stopReceiving();
+    if (_hasReplied) {
+        return;
+    }
+
     auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
-    replyPacket->writePrimitive(messageID);
-    
-    if (fileSize > _filesizeLimit) {
-        replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+    replyPacket->writePrimitive(_messageID);
+    QString storedHash;
+
+    bool chunksFound = true;
+    if (_receivedMessage->getType() == PacketType::AssetUploadChunks && !_writeFailed) {
+        chunksFound = receiveChunks([this](const QByteArray& data) {
+            _hash.addData(data);
+            _writeFailed = _file.write(data) != data.size();
+            _bytesReceived += data.size();
+        });
+    }
+
+    if (!chunksFound) {
+        // the chunk was deleted since the sender asked for it, the sender uploads the whole asset instead
+        qWarning() << "Upload of" << _fileSize << "bytes refers to a chunk the asset server no longer holds - upload failed.";
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+    } else if (_writeFailed || !_file.flush()) {
+        qWarning() << "Failed to write uploaded file to disk - upload failed.";
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+    } else if (_bytesReceived < _fileSize) {
+        qWarning() << "Upload of" << _fileSize << "bytes only carried" << _bytesReceived << "bytes - upload failed.";
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
-        auto hash = AssetUtils::hashData(fileData);
-        auto hexHash = hash.toHex();
+        auto hashResult = _hash.result();
+        auto hexHash = hashResult.toHex();
 
         if (_senderNode) {
             qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "is: (" << hexHash << ")";
         } else {
             qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
         }
-        
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
 
-        bool existingCorrectFile = false;
-        
-        if (file.exists()) {
-            // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
-                qDebug() << "Not overwriting existing verified file: " << hexHash;
+        QString filePath = _storage->getFilePath(hexHash);
+        QFileInfo existingFile { filePath };
 
-                existingCorrectFile = true;
+        // files are named by the hash of their contents, so a file of the same name and size already holds the asset
+        if (existingFile.exists() && existingFile.size() == qint64(_fileSize)) {
+            qDebug() << "Not overwriting existing file: " << hexHash;
 
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
+            replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+            replyPacket->write(hashResult);
+            storedHash = hexHash;
+        } else {
+            if (existingFile.exists()) {
+                qDebug() << "Overwriting an existing file whose size did not match the upload: " << hexHash;
+                QFile::remove(filePath);
+                if (_chunkStore) {
+                    _chunkStore->remove(hexHash);
+                }
             }
-        }
 
-        if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
+            // the directory the file goes in may not exist yet
+            filePath = _storage->createFilePath(hexHash);
+
+            _file.setAutoRemove(false);
+            if (!filePath.isEmpty() && _file.rename(filePath)) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
+
+                if (_assetCache) {
+                    _assetCache->remove(hexHash);
+                }
 
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
+                replyPacket->write(hashResult);
+                storedHash = hexHash;
             } else {
-                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
+                qWarning() << "Failed to move uploaded file" << hexHash << "in place - upload failed.";
 
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
+                // upload has failed - drop the temporary file and return an error
+                _file.remove();
 
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
-                }
-                
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
             }
         }
+    }
 
+    sendReply(std::move(replyPacket));
 
+    // list the chunks of the new asset once the sender has its reply, so the next version of it can be sent as a delta
+    if (_chunkStore && !storedHash.isEmpty()) {
+        _chunkStore->getChunks(storedHash);
     }
-    
+}
+
+void UploadAssetTask::stopReceiving() {
+    // the connections hold on to the task, letting go of them lets it be deleted once its last run is done
+    _isDone = true;
+    QObject::disconnect(_progressConnection);
+    QObject::disconnect(_completedConnection);
+}
+
+void UploadAssetTask::sendReply(std::unique_ptr<NLPacket> replyPacket) {
+    _hasReplied = true;
+
     auto nodeList = DependencyManager::get<NodeList>();
     if (_senderNode) {
         nodeList->sendPacket(std::move(replyPacket), *_senderNode);
@@ -115,3 +252,51 @@ void UploadAssetTask::run() {
         nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
     }
 }
+
+bool UploadAssetTask::receiveChunks(const std::function<void(const QByteArray&)>& writeData) {
+    // every chunk is described by its length, its hash and whether its data is part of the upload
+    static const qint64 CHUNK_ENTRY_SIZE = sizeof(uint32_t) + AssetUtils::SHA256_HASH_LENGTH + sizeof(uint8_t);
+
+    uint32_t numChunks = 0;
+    _receivedMessage->readPrimitive(&numChunks);
+    if ((qint64)numChunks * CHUNK_ENTRY_SIZE > _receivedMessage->getBytesLeftToRead()) {
+        qWarning() << "Chunked upload lists more chunks than it carries.";
+        return true;
+    }
+
+    struct UploadedChunk {
+        uint32_t length;
+        QByteArray hash;
+        uint8_t isIncluded;
+    };
+    std::vector<UploadedChunk> chunks(numChunks);
+    for (auto& chunk : chunks) {
+        _receivedMessage->readPrimitive(&chunk.length);
+        chunk.hash = _receivedMessage->read(AssetUtils::SHA256_HASH_LENGTH);
+        _receivedMessage->readPrimitive(&chunk.isIncluded);
+    }
+
+    uint64_t bytesWritten = 0;
+    for (const auto& chunk : chunks) {
+        if (_writeFailed || bytesWritten + chunk.length > _fileSize) {
+            // the size check after the chunks are written fails the upload
+            return true;
+        }
+
+        QByteArray data;
+        if (chunk.isIncluded) {
+            data = _receivedMessage->read(chunk.length);
+        } else if (_chunkStore) {
+            data = _chunkStore->readChunk(chunk.hash);
+            if (data.size() != (int)chunk.length) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+
+        writeData(data);
+        bytesWritten += data.size();
+    }
+    return true;
+}
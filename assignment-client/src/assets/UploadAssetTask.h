@@ -14,28 +14,76 @@
 #ifndef hifi_UploadAssetTask_h
 #define hifi_UploadAssetTask_h
 
-#include <QtCore/QDir>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QObject>
-#include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QTemporaryFile>
 
+#include "ClientServerUtils.h"
 #include "ReceivedMessage.h"
 
+class AssetCache;
+class AssetChunkStore;
+class AssetStorage;
+class NLPacket;
 class NLPacketList;
 class Node;
+class QThreadPool;
 
-class UploadAssetTask : public QRunnable {
+/// Writes an upload to disk on the task pool as its packets arrive. No thread of the pool waits for the packets, each
+/// batch of them is written by a run of its own. The task keeps itself alive until it has replied to the sender.
+class UploadAssetTask : public QEnableSharedFromThis<UploadAssetTask> {
 public:
+    // uploads are written to files starting with this in the files directory until they are complete
+    static const QString TEMPORARY_FILE_PREFIX;
+
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const AssetStorage* storage, uint64_t filesizeLimit, QThreadPool* taskPool,
+                    AssetCache* assetCache = nullptr, AssetChunkStore* chunkStore = nullptr);
 
-    void run() override;
+    /// Start writing the upload, the task must be owned by a QSharedPointer
+    void start();
 
 private:
+    friend class UploadAssetRunnable;
+
+    void scheduleRun();
+    void run();
+    void receiveAvailable();
+    void finish();
+    void stopReceiving();
+    void sendReply(std::unique_ptr<NLPacket> replyPacket);
+
+    /// Writes the data of a chunked upload, reading the chunks it leaves out from the chunk store. Returns false if
+    /// one of them is no longer held by any asset.
+    bool receiveChunks(const std::function<void(const QByteArray&)>& writeData);
+
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
-    QDir _resourcesDir;
+    const AssetStorage* _storage;
     uint64_t _filesizeLimit;
+    QThreadPool* _taskPool;
+    AssetCache* _assetCache;
+    AssetChunkStore* _chunkStore;
+
+    QMetaObject::Connection _progressConnection;
+    QMetaObject::Connection _completedConnection;
+    std::atomic<int> _numPendingRuns { 0 };
+
+    // only touched by the runs, which never overlap
+    bool _isHeaderRead { false };
+    bool _hasReplied { false };
+    bool _isDone { false };
+    MessageID _messageID { 0 };
+    uint64_t _fileSize { 0 };
+    QTemporaryFile _file;
+    QCryptographicHash _hash { QCryptographicHash::Sha256 };
+    uint64_t _bytesReceived { 0 };
+    bool _writeFailed { false };
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -15,15 +15,35 @@
 #include <udt/PacketHeaders.h>
 
 #include <DependencyManager.h>
+#include <ExtendedIODevice.h>
 #include <NodeList.h>
 
 #include "AvatarMixerSlave.h"
 
+// appends to a QByteArray so that traits can be packed once, outside of any particular listener's packet list
+class PackedTraitDevice : public ExtendedIODevice {
+public:
+    PackedTraitDevice(QByteArray& data) : _data(data) { open(QIODevice::WriteOnly); }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override { return -1; }
+    qint64 writeData(const char* data, qint64 maxSize) override {
+        _data.append(data, (int)maxSize);
+        return maxSize;
+    }
+
+private:
+    QByteArray& _data;
+};
+
 AvatarMixerClientData::AvatarMixerClientData(const QUuid& nodeID, Node::LocalID nodeLocalID) :
     NodeData(nodeID, nodeLocalID)
 {
     // in case somebody calls getSessionUUID on the AvatarData instance, make sure it has the right ID
     _avatar->setID(nodeID);
+
+    // joints are decoded when a listener first needs them, not as each packet comes in
+    _avatar->setLazyJointDecoding(true);
 }
 
 uint64_t AvatarMixerClientData::getLastOtherAvatarEncodeTime(NLPacket::LocalID otherAvatar) const {
@@ -126,6 +146,8 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                     checkSkeletonURLAgainstWhitelist(slaveSharedData, sendingNode, packetTraitVersion);
                 }
 
+                packTrait(traitType, packetTraitVersion);
+
                 anyTraitsChanged = true;
             } else {
                 message.seek(message.getPosition() + traitSize);
@@ -161,6 +183,13 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                         instanceVersionRef = packetTraitVersion;
                     }
 
+                    if (instanceVersionRef < 0) {
+                        // deletes are small enough to pack per listener, drop the packed instance with the trait
+                        _packedTraitInstances.erase(instanceID);
+                    } else {
+                        packTraitInstance(traitType, instanceID, instanceVersionRef);
+                    }
+
                     anyTraitsChanged = true;
                 } else {
                     message.seek(message.getPosition() + traitSize);
@@ -177,6 +206,54 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
     }
 }
 
+void AvatarMixerClientData::packTrait(AvatarTraits::TraitType traitType, AvatarTraits::TraitVersion traitVersion) {
+    auto packedTrait = std::make_shared<QByteArray>();
+    PackedTraitDevice traitDevice(*packedTrait);
+    _avatar->packTrait(traitType, traitDevice, traitVersion);
+
+    _packedTraits[traitType] = packedTrait;
+}
+
+void AvatarMixerClientData::packTraitInstance(AvatarTraits::TraitType traitType, AvatarTraits::TraitInstanceID instanceID,
+                                              AvatarTraits::TraitVersion traitVersion) {
+    auto packedTrait = std::make_shared<QByteArray>();
+    PackedTraitDevice traitDevice(*packedTrait);
+    _avatar->packTraitInstance(traitType, instanceID, traitDevice, traitVersion);
+
+    _packedTraitInstances[instanceID] = packedTrait;
+}
+
+AvatarMixerClientData::PackedTrait AvatarMixerClientData::getPackedTrait(AvatarTraits::TraitType traitType) const {
+    return _packedTraits[traitType];
+}
+
+AvatarMixerClientData::PackedTrait AvatarMixerClientData::getPackedTraitInstance(AvatarTraits::TraitInstanceID instanceID) const {
+    auto it = _packedTraitInstances.find(instanceID);
+    if (it != _packedTraitInstances.end()) {
+        return it->second;
+    } else {
+        return PackedTrait();
+    }
+}
+
+QByteArray AvatarMixerClientData::getIdentityByteArray() const {
+    // several slaves can ask for the same identity during a broadcast, only the first one serializes it
+    std::lock_guard<std::mutex> lock(_identityCacheMutex);
+
+    // the mixer pushes a new sequence number when it changes a session display name without flagging
+    // another identity change, and receivers drop identities that don't carry a newer sequence number
+    auto sequenceNumber = _avatar->getIdentitySequenceNumber();
+    if (_identityCache.isEmpty() || _identityCacheTimestamp != _identityChangeTimestamp
+        || _identityCacheSequenceNumber != sequenceNumber) {
+        _identityCache = _avatar->identityByteArray();
+        _identityCache.replace(0, NUM_BYTES_RFC4122_UUID, getNodeID().toRfc4122());
+        _identityCacheTimestamp = _identityChangeTimestamp;
+        _identityCacheSequenceNumber = sequenceNumber;
+    }
+
+    return _identityCache;
+}
+
 void AvatarMixerClientData::checkSkeletonURLAgainstWhitelist(const SlaveSharedData &slaveSharedData, Node& sendingNode,
                                                              AvatarTraits::TraitVersion traitVersion) {
     const auto& whitelist = slaveSharedData.skeletonURLWhitelist;
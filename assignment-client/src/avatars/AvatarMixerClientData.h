@@ -13,7 +13,10 @@
 #define hifi_AvatarMixerClientData_h
 
 #include <algorithm>
+#include <array>
 #include <cfloat>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <queue>
@@ -66,6 +69,9 @@ public:
 
     uint64_t getIdentityChangeTimestamp() const { return _identityChangeTimestamp; }
     void flagIdentityChange() { _identityChangeTimestamp = usecTimestampNow(); }
+
+    // serialized once per identity change and shared by every listener that needs it
+    QByteArray getIdentityByteArray() const;
     bool getAvatarSessionDisplayNameMustChange() const { return _avatarSessionDisplayNameMustChange; }
     void setAvatarSessionDisplayNameMustChange(bool set = true) { _avatarSessionDisplayNameMustChange = set; }
 
@@ -138,9 +144,18 @@ public:
 
     AvatarTraits::TraitVersions& getLastSentTraitVersions(Node::LocalID otherAvatar) { return _sentTraitVersions[otherAvatar]; }
 
+    // traits are packed once per received version, listeners write the same immutable bytes into their traits packets
+    using PackedTrait = std::shared_ptr<const QByteArray>;
+    PackedTrait getPackedTrait(AvatarTraits::TraitType traitType) const;
+    PackedTrait getPackedTraitInstance(AvatarTraits::TraitInstanceID instanceID) const;
+
     void resetSentTraitData(Node::LocalID nodeID);
 
 private:
+    void packTrait(AvatarTraits::TraitType traitType, AvatarTraits::TraitVersion traitVersion);
+    void packTraitInstance(AvatarTraits::TraitType traitType, AvatarTraits::TraitInstanceID instanceID,
+                           AvatarTraits::TraitVersion traitVersion);
+
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
     };
@@ -157,7 +172,12 @@ private:
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<NLPacket::LocalID, QVector<JointData>> _lastOtherAvatarSentJoints;
 
-    uint64_t _identityChangeTimestamp;
+    uint64_t _identityChangeTimestamp { 0 };
+
+    mutable std::mutex _identityCacheMutex;
+    mutable QByteArray _identityCache;
+    mutable uint64_t _identityCacheTimestamp { 0 };
+    mutable udt::SequenceNumber _identityCacheSequenceNumber { 0 };
     bool _avatarSessionDisplayNameMustChange{ true };
     bool _avatarSkeletonModelUrlMustChange{ false };
 
@@ -180,6 +200,9 @@ private:
     AvatarTraits::TraitVersions _lastReceivedTraitVersions;
     TraitsCheckTimestamp _lastReceivedTraitsChange;
 
+    std::array<PackedTrait, AvatarTraits::TotalTraitTypes> _packedTraits;
+    std::unordered_map<AvatarTraits::TraitInstanceID, PackedTrait, UUIDHasher> _packedTraitInstances;
+
     std::unordered_map<Node::LocalID, TraitsCheckTimestamp> _lastSentTraitsTimestamps;
     std::unordered_map<Node::LocalID, AvatarTraits::TraitVersions> _sentTraitVersions;
 
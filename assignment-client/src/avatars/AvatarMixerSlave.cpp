@@ -70,8 +70,7 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
 
 int AvatarMixerSlave::sendIdentityPacket(NLPacketList& packetList, const AvatarMixerClientData* nodeData, const Node& destinationNode) {
     if (destinationNode.getType() == NodeType::Agent && !destinationNode.isUpstream()) {
-        QByteArray individualData = nodeData->getConstAvatarData()->identityByteArray();
-        individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122()); // FIXME, this looks suspicious
+        QByteArray individualData = nodeData->getIdentityByteArray();
         packetList.write(individualData);
         _stats.numIdentityPackets++;
         return individualData.size();
@@ -82,7 +81,8 @@ int AvatarMixerSlave::sendIdentityPacket(NLPacketList& packetList, const AvatarM
 
 qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* listeningNodeData,
                                                       const AvatarMixerClientData* sendingNodeData,
-                                                      NLPacketList& traitsPacketList) {
+                                                      NLPacketList& traitsPacketList,
+                                                      qint64 traitBytesSentThisFrame, qint64 maxTraitBytesPerFrame) {
 
     auto otherNodeLocalID = sendingNodeData->getNodeLocalID();
 
@@ -96,6 +96,25 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
     if (timeOfLastTraitsChange > timeOfLastTraitsSent) {
         // there is definitely new traits data to send
 
+        if (traitBytesSentThisFrame > 0 && traitBytesSentThisFrame >= maxTraitBytesPerFrame) {
+            // the traits budget for this listener is spent, higher priority avatars already got theirs this frame
+            _stats.numTraitsDeferred++;
+            return 0;
+        }
+
+        // large traits (avatar entities) that don't fit in what is left of the budget wait for a later frame,
+        // unless nothing has been sent yet this frame, so that a trait larger than the whole budget still goes out
+        bool allTraitsSent = true;
+        auto fitsInBudget = [&](const AvatarMixerClientData::PackedTrait& packedTrait) {
+            qint64 bytesSoFar = traitBytesSentThisFrame + bytesWritten;
+            if (bytesSoFar > 0 && packedTrait && bytesSoFar + packedTrait->size() > maxTraitBytesPerFrame) {
+                allTraitsSent = false;
+                _stats.numTraitsDeferred++;
+                return false;
+            }
+            return true;
+        };
+
         // add the avatar ID to mark the beginning of traits for this avatar
         bytesWritten += traitsPacketList.write(sendingNodeData->getNodeID().toRfc4122());
 
@@ -114,8 +133,18 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
             auto& lastSentVersionRef = lastSentVersions[traitType];
 
             if (lastReceivedVersions[traitType] > lastSentVersionRef) {
+                auto packedTrait = sendingNodeData->getPackedTrait(traitType);
+                if (!fitsInBudget(packedTrait)) {
+                    ++simpleReceivedIt;
+                    continue;
+                }
+
                 // there is an update to this trait, add it to the traits packet
-                bytesWritten += sendingAvatar->packTrait(traitType, traitsPacketList, lastReceivedVersion);
+                if (packedTrait) {
+                    bytesWritten += traitsPacketList.write(*packedTrait);
+                } else {
+                    bytesWritten += sendingAvatar->packTrait(traitType, traitsPacketList, lastReceivedVersion);
+                }
 
                 // update the last sent version
                 lastSentVersionRef = lastReceivedVersion;
@@ -149,20 +178,38 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
                                                        return sentInstance.id == instanceID;
                                                    });
 
-                if (!isDeleted && (sentInstanceIt == sentIDValuePairs.end() || receivedVersion > sentInstanceIt->value)) {
+                bool needsSend = (!isDeleted && (sentInstanceIt == sentIDValuePairs.end() || receivedVersion > sentInstanceIt->value))
+                    || (isDeleted && sentInstanceIt != sentIDValuePairs.end() && absoluteReceivedVersion > sentInstanceIt->value);
+                if (!needsSend) {
+                    continue;
+                }
+
+                auto packedTrait = sendingNodeData->getPackedTraitInstance(instanceID);
+                if (!fitsInBudget(packedTrait)) {
+                    continue;
+                }
 
+                if (!isDeleted) {
                     // this instance version exists and has never been sent or is newer so we need to send it
-                    bytesWritten += sendingAvatar->packTraitInstance(traitType, instanceID, traitsPacketList, receivedVersion);
+                    if (packedTrait) {
+                        bytesWritten += traitsPacketList.write(*packedTrait);
+                    } else {
+                        bytesWritten += sendingAvatar->packTraitInstance(traitType, instanceID, traitsPacketList, receivedVersion);
+                    }
 
                     if (sentInstanceIt != sentIDValuePairs.end()) {
                         sentInstanceIt->value = receivedVersion;
                     } else {
                         sentIDValuePairs.emplace_back(instanceID, receivedVersion);
                     }
-                } else if (isDeleted && sentInstanceIt != sentIDValuePairs.end() && absoluteReceivedVersion > sentInstanceIt->value) {
-
+                } else {
                     // this instance version was deleted and we haven't sent the delete to this client yet
-                    bytesWritten += AvatarTraits::packInstancedTraitDelete(traitType, instanceID, traitsPacketList, absoluteReceivedVersion);
+                    if (packedTrait) {
+                        bytesWritten += traitsPacketList.write(*packedTrait);
+                    } else {
+                        bytesWritten += AvatarTraits::packInstancedTraitDelete(traitType, instanceID, traitsPacketList,
+                                                                               absoluteReceivedVersion);
+                    }
 
                     // update the last sent version for this trait instance to the absolute value of the deleted version
                     sentInstanceIt->value = absoluteReceivedVersion;
@@ -175,9 +222,11 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
         // write a null trait type to mark the end of trait data for this avatar
         bytesWritten += traitsPacketList.writePrimitive(AvatarTraits::NullTrait);
 
-        // since we send all traits for this other avatar, update the time of last traits sent
-        // to match the time of last traits change
-        listeningNodeData->setLastOtherAvatarTraitsSendPoint(otherNodeLocalID, timeOfLastTraitsChange);
+        // if we sent all traits for this other avatar, update the time of last traits sent
+        // to match the time of last traits change, otherwise we'll pick up the deferred traits next frame
+        if (allTraitsSent) {
+            listeningNodeData->setLastOtherAvatarTraitsSendPoint(otherNodeLocalID, timeOfLastTraitsChange);
+        }
     }
 
 
@@ -259,6 +308,10 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     // max number of avatarBytes per frame
     int maxAvatarBytesPerFrame = int(_maxKbpsPerNode * BYTES_PER_KILOBIT / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
 
+    // traits are rate limited separately with the same per-frame allowance, since they are sent reliably
+    // and avatars are visited in priority order, the closest avatars get their traits first
+    qint64 maxTraitBytesPerFrame = maxAvatarBytesPerFrame;
+
     // keep track of the number of other avatars held back in this frame
     int numAvatarsHeldBack = 0;
 
@@ -498,7 +551,8 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             (quint64) chrono::duration_cast<chrono::microseconds>(endAvatarDataPacking - startAvatarDataPacking).count();
 
         // use helper to add any changed traits to our packet list
-        traitBytesSent += addChangedTraitsToBulkPacket(nodeData, otherNodeData, *traitsPacketList);
+        traitBytesSent += addChangedTraitsToBulkPacket(nodeData, otherNodeData, *traitsPacketList,
+                                                       traitBytesSent, maxTraitBytesPerFrame);
         remainingAvatars--;
     }
 
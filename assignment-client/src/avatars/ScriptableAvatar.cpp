@@ -137,6 +137,7 @@ void ScriptableAvatar::update(float deltatime) {
                     data.translationIsDefaultPose = false;
                 }
             }
+            markJointDataChanged();
 
         } else {
             _animation.clear();
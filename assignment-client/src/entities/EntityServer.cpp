@@ -321,6 +321,33 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
         tree->setEntityMaxTmpLifetime(EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME);
     }
 
+    int editCoalescingWindowMsecs;
+    if (readOptionInt("editCoalescingWindow", settingsSectionObject, editCoalescingWindowMsecs)) {
+        tree->setEditCoalescingWindow(std::max(editCoalescingWindowMsecs, 0) * USECS_PER_MSEC);
+    } else {
+        tree->setEditCoalescingWindow(EntityTree::DEFAULT_EDIT_COALESCING_WINDOW);
+    }
+
+    // a comma separated list of entity types and their windows in msecs, like "Zone:0,Model:20"
+    QString editCoalescingWindowsByType;
+    if (readOptionString("editCoalescingWindowsByType", settingsSectionObject, editCoalescingWindowsByType)) {
+        for (const auto& typeWindow : editCoalescingWindowsByType.split(',', QString::SkipEmptyParts)) {
+            auto typeAndWindow = typeWindow.split(':');
+            bool ok = typeAndWindow.size() == 2;
+            EntityTypes::EntityType entityType = EntityTypes::Unknown;
+            int windowMsecs = 0;
+            if (ok) {
+                entityType = EntityTypes::getEntityTypeFromName(typeAndWindow[0].trimmed());
+                windowMsecs = typeAndWindow[1].trimmed().toInt(&ok);
+            }
+            if (!ok || entityType == EntityTypes::Unknown || windowMsecs < 0) {
+                qWarning() << "Ignoring invalid edit coalescing window" << typeWindow;
+                continue;
+            }
+            tree->setEditCoalescingWindow(entityType, windowMsecs * USECS_PER_MSEC);
+        }
+    }
+
     int minTime;
     if (readOptionInt("dynamicDomainVerificationTimeMin", settingsSectionObject, minTime)) {
         _MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = minTime * 1000;
@@ -411,6 +438,16 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    // display how often sends could use an entity's cached encoding
+    quint64 encodedDataCacheHits = EntityItem::getEncodedDataCacheHits();
+    quint64 encodedDataCacheMisses = EntityItem::getEncodedDataCacheMisses();
+    quint64 encodedDataCacheLookups = encodedDataCacheHits + encodedDataCacheMisses;
+    statsString += "<b>Entity Server Encoding Statistics</b>\r\n";
+    statsString += QString().sprintf("Cached encodings used... %llu (%5.2f%%)\r\n", (unsigned long long)encodedDataCacheHits,
+        encodedDataCacheLookups > 0 ? (double)encodedDataCacheHits / (double)encodedDataCacheLookups * 100.0 : 0.0);
+    statsString += QString().sprintf("   Entities re-encoded... %llu\r\n", (unsigned long long)encodedDataCacheMisses);
+    statsString += "\r\n\r\n";
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
@@ -16,6 +16,8 @@
 
 #include <memory>
 
+#include <CoarseVisibility.h>
+
 #include "EntityItem.h"
 #include "EntityServerConsts.h"
 #include "EntityTree.h"
@@ -60,6 +62,9 @@ public:
 
     virtual void aboutToFinish() override;
 
+    // shared by the traversals of all our send threads
+    CoarseVisibilityCache& getCoarseVisibilityCache() { return _coarseVisibilityCache; }
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -78,6 +83,8 @@ private:
     SimpleEntitySimulationPointer _entitySimulation;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
+    CoarseVisibilityCache _coarseVisibilityCache;
+
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 
@@ -29,10 +29,34 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
 }
 
 void EntityTreeSendThread::resetState() {
-    qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
+    std::lock_guard<std::mutex> lock(_pendingEventsMutex);
+    _resetStatePending = true;
+}
+
+void EntityTreeSendThread::processPendingEntityEvents() {
+    bool resetStatePending = false;
+    std::vector<PendingEntityEvent> pendingEvents;
+    {
+        std::lock_guard<std::mutex> lock(_pendingEventsMutex);
+        std::swap(resetStatePending, _resetStatePending);
+        pendingEvents.swap(_pendingEntityEvents);
+        _pendingEditedEntities.clear();
+    }
+
+    if (resetStatePending) {
+        qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
 
-    _knownState.clear();
-    _traversal.reset();
+        _knownState.clear();
+        _traversal.reset();
+    }
+
+    for (const auto& event : pendingEvents) {
+        if (event.deleted) {
+            _knownState.erase(event.deleted);
+        } else {
+            applyEntityEdit(event.edited);
+        }
+    }
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -101,6 +125,8 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
+    processPendingEntityEvents();
+
     if (viewFrustumChanged || _traversal.finished()) {
         EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
@@ -222,7 +248,8 @@ bool EntityTreeSendThread::addDescendantsToExtraFlaggedEntities(const QUuid& fil
 
 void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root) {
 
-    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, root);
+    auto& coarseVisibilityCache = static_cast<EntityServer*>(_myServer)->getCoarseVisibilityCache();
+    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, root, &coarseVisibilityCache);
     // there are three types of traversal:
     //
     //      (1) FirstTime = at login --> find everything in view
@@ -371,7 +398,7 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
-                OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData);
+                OctreeElement::AppendState appendEntityState = entity->appendCachedEntityData(&_packetData, params, _extraEncodeData);
 
                 if (appendEntityState != OctreeElement::COMPLETED) {
                     if (appendEntityState == OctreeElement::PARTIAL) {
@@ -413,6 +440,15 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
 }
 
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
+    if (entity) {
+        std::lock_guard<std::mutex> lock(_pendingEventsMutex);
+        if (_pendingEditedEntities.insert(entity.get()).second) {
+            _pendingEntityEvents.push_back({ entity, nullptr });
+        }
+    }
+}
+
+void EntityTreeSendThread::applyEntityEdit(const EntityItemPointer& entity) {
     if (entity) {
         if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
             const auto& view = _traversal.getCurrentView();
@@ -429,5 +465,7 @@ void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity)
 }
 
 void EntityTreeSendThread::deletingEntityPointer(EntityItem* entity) {
-    _knownState.erase(entity);
+    std::lock_guard<std::mutex> lock(_pendingEventsMutex);
+    _pendingEditedEntities.erase(entity);
+    _pendingEntityEvents.push_back({ EntityItemPointer(), entity });
 }
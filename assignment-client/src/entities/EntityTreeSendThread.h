@@ -12,7 +12,9 @@
 #ifndef hifi_EntityTreeSendThread_h
 #define hifi_EntityTreeSendThread_h
 
+#include <mutex>
 #include <unordered_set>
+#include <vector>
 
 #include "../octree/OctreeSendThread.h"
 
@@ -42,6 +44,10 @@ private:
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
+    // applies the edits, deletes and resets that were signalled since our last pass
+    void processPendingEntityEvents();
+    void applyEntityEdit(const EntityItemPointer& entity);
+
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
@@ -58,6 +64,17 @@ private:
     int32_t _numEntitiesOffset { 0 };
     uint16_t _numEntities { 0 };
 
+    // the slots below run on the thread that owns us while our passes run on an OctreeSendPool worker,
+    // so they only record what happened here and the next pass applies it
+    struct PendingEntityEvent {
+        EntityItemPointer edited;
+        EntityItem* deleted { nullptr };
+    };
+    std::mutex _pendingEventsMutex;
+    std::vector<PendingEntityEvent> _pendingEntityEvents; // guarded by _pendingEventsMutex
+    std::unordered_set<EntityItem*> _pendingEditedEntities; // guarded by _pendingEventsMutex
+    bool _resetStatePending { false }; // guarded by _pendingEventsMutex
+
 private slots:
     void editingEntityPointer(const EntityItemPointer& entity);
     void deletingEntityPointer(EntityItem* entity);
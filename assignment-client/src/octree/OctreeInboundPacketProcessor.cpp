@@ -11,6 +11,7 @@
 
 #include "OctreeInboundPacketProcessor.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <NumericalConstants.h>
@@ -30,6 +31,8 @@ OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServe
     _totalProcessTime(0),
     _totalLockWaitTime(0),
     _totalElementsInPacket(0),
+    _totalInPlaceElements(0),
+    _totalHeldElements(0),
     _totalPackets(0),
     _lastNackTime(usecTimestampNow()),
     _shuttingDown(false)
@@ -41,6 +44,8 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalProcessTime = 0;
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
+    _totalInPlaceElements = 0;
+    _totalHeldElements = 0;
     _totalPackets = 0;
     _lastNackTime = usecTimestampNow();
 
@@ -51,6 +56,11 @@ void OctreeInboundPacketProcessor::resetStats() {
 uint32_t OctreeInboundPacketProcessor::getMaxWait() const {
     // calculate time until next sendNackPackets()
     quint64 nextNackTime = _lastNackTime + TOO_LONG_SINCE_LAST_NACK;
+    // or until the next held edit is due, if that is sooner
+    quint64 nextHeldEditRelease = _myServer->getOctree()->getNextHeldEditRelease();
+    if (nextHeldEditRelease != 0) {
+        nextNackTime = std::min(nextNackTime, nextHeldEditRelease);
+    }
     quint64 now = usecTimestampNow();
     if (now >= nextNackTime) {
         return 0;
@@ -59,6 +69,9 @@ uint32_t OctreeInboundPacketProcessor::getMaxWait() const {
 }
 
 void OctreeInboundPacketProcessor::preProcess() {
+    // apply the held edits that are due, or all of them once we are shutting down
+    applyHeldEdits(_shuttingDown);
+
     // check if it's time to send a nack. If yes, do so
     quint64 now = usecTimestampNow();
     if (now - _lastNackTime >= TOO_LONG_SINCE_LAST_NACK) {
@@ -68,6 +81,8 @@ void OctreeInboundPacketProcessor::preProcess() {
 }
 
 void OctreeInboundPacketProcessor::midProcess() {
+    applyHeldEdits(false);
+
     // check if it's time to send a nack. If yes, do so
     quint64 now = usecTimestampNow();
     if (now - _lastNackTime >= TOO_LONG_SINCE_LAST_NACK) {
@@ -76,6 +91,46 @@ void OctreeInboundPacketProcessor::midProcess() {
     }
 }
 
+int OctreeInboundPacketProcessor::applyEdit(ReceivedMessage& message, const unsigned char* editData, int maxSize,
+                                            const SharedNodePointer& sendingNode, quint64& lockWaitTime) {
+    // edits that leave the structure of the tree alone are applied under the read lock,
+    // so that send and persist traversals don't have to wait for them
+    int editDataBytesRead = 0;
+    bool appliedInPlace = false;
+    quint64 startLock = usecTimestampNow();
+    _myServer->getOctree()->withReadLock([&] {
+        lockWaitTime += usecTimestampNow() - startLock;
+        appliedInPlace = _myServer->getOctree()->processInPlaceEditPacketData(message, editData, maxSize,
+                                                                              sendingNode, editDataBytesRead);
+    });
+
+    if (appliedInPlace) {
+        _totalInPlaceElements++;
+    } else {
+        quint64 startWriteLock = usecTimestampNow();
+        _myServer->getOctree()->withWriteLock([&] {
+            lockWaitTime += usecTimestampNow() - startWriteLock;
+            editDataBytesRead = _myServer->getOctree()->processEditPacketData(message, editData, maxSize, sendingNode);
+        });
+    }
+    return editDataBytesRead;
+}
+
+void OctreeInboundPacketProcessor::applyReadyEdits(std::vector<Octree::HeldEdit>& readyEdits) {
+    for (auto& readyEdit : readyEdits) {
+        auto editData = reinterpret_cast<const unsigned char*>(readyEdit.message->getRawMessage() + readyEdit.offset);
+        quint64 lockWaitTime = 0;
+        applyEdit(*readyEdit.message, editData, readyEdit.length, readyEdit.sourceNode, lockWaitTime);
+    }
+    readyEdits.clear();
+}
+
+void OctreeInboundPacketProcessor::applyHeldEdits(bool releaseAll) {
+    std::vector<Octree::HeldEdit> readyEdits;
+    _myServer->getOctree()->releaseHeldEdits(releaseAll, readyEdits);
+    applyReadyEdits(readyEdits);
+}
+
 void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (_shuttingDown) {
         qDebug() << "OctreeInboundPacketProcessor::processPacket() while shutting down... ignoring incoming packet";
@@ -170,13 +225,25 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                         message->getPosition(), maxSize);
             }
 
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
+            quint64 startLock = usecTimestampNow();
+            quint64 thisLockWaitTime = 0;
+            int editDataBytesRead = 0;
+
+            // the tree may hold the edit back, and drop it if a later edit supersedes it before it is due
+            std::vector<Octree::HeldEdit> readyEdits;
+            bool held = false;
+            _myServer->getOctree()->withReadLock([&] {
+                thisLockWaitTime += usecTimestampNow() - startLock;
+                held = _myServer->getOctree()->holdEditPacketData(message, editData, maxSize, sendingNode,
+                                                                  editDataBytesRead, readyEdits);
             });
+
+            applyReadyEdits(readyEdits);
+            if (held) {
+                _totalHeldElements++;
+            } else {
+                editDataBytesRead = applyEdit(*message, editData, maxSize, sendingNode, thisLockWaitTime);
+            }
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
@@ -185,8 +252,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             }
 
             editsInPacket++;
-            quint64 thisProcessTime = endProcess - startProcess;
-            quint64 thisLockWaitTime = startProcess - startLock;
+            quint64 thisProcessTime = endProcess - startLock - thisLockWaitTime;
             processTime += thisProcessTime;
             lockWaitTime += thisLockWaitTime;
 
@@ -14,6 +14,7 @@
 #ifndef hifi_OctreeInboundPacketProcessor_h
 #define hifi_OctreeInboundPacketProcessor_h
 
+#include <Octree.h>
 #include <ReceivedPacketProcessor.h>
 
 #include "SequenceNumberStats.h"
@@ -64,6 +65,8 @@ public:
     quint64 getAverageProcessTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalProcessTime / _totalPackets; }
     quint64 getAverageLockWaitTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalLockWaitTime / _totalPackets; }
     quint64 getTotalElementsProcessed() const { return _totalElementsInPacket; }
+    quint64 getTotalInPlaceElementsProcessed() const { return _totalInPlaceElements; }
+    quint64 getTotalHeldElementsProcessed() const { return _totalHeldElements; }
     quint64 getTotalPacketsProcessed() const { return _totalPackets; }
     quint64 getAverageProcessTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalProcessTime / _totalElementsInPacket; }
@@ -87,6 +90,11 @@ protected:
 private:
     int sendNackPackets();
 
+    int applyEdit(ReceivedMessage& message, const unsigned char* editData, int maxSize,
+                  const SharedNodePointer& sendingNode, quint64& lockWaitTime);
+    void applyHeldEdits(bool releaseAll);
+    void applyReadyEdits(std::vector<Octree::HeldEdit>& readyEdits);
+
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
@@ -98,6 +106,8 @@ private:
     std::atomic<uint64_t> _totalProcessTime;
     std::atomic<uint64_t> _totalLockWaitTime;
     std::atomic<uint64_t> _totalElementsInPacket;
+    std::atomic<uint64_t> _totalInPlaceElements;
+    std::atomic<uint64_t> _totalHeldElements;
     std::atomic<uint64_t> _totalPackets;
     
     NodeToSenderStatsMap _singleSenderStats;
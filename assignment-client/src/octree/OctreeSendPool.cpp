@@ -0,0 +1,152 @@
+//
+//  OctreeSendPool.cpp
+//  assignment-client/src/octree
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendPool.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <chrono>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+// passes that start this long after their deadline are counted as late
+const quint64 LATE_PASS_THRESHOLD_USECS = OCTREE_SEND_INTERVAL_USECS / 4;
+
+void OctreeSendWorker::run() {
+    OctreeSendPool::ScheduledJob scheduled;
+    while (_pool.next(scheduled)) {
+        quint64 passStart = usecTimestampNow();
+        bool keepRunning = scheduled.job->sendPass();
+        _pool.done(scheduled, passStart, keepRunning);
+    }
+}
+
+OctreeSendPool::OctreeSendPool(int numThreads) {
+    numThreads = std::max(numThreads, 1);
+
+    for (int i = 0; i < numThreads; ++i) {
+        auto worker = std::unique_ptr<OctreeSendWorker>(new OctreeSendWorker(*this));
+        worker->setObjectName(QString("Octree Send Worker %1").arg(i));
+        worker->start();
+        _workers.push_back(std::move(worker));
+    }
+}
+
+OctreeSendPool::~OctreeSendPool() {
+    {
+        Lock lock(_mutex);
+        _stop = true;
+    }
+    _workerCondition.notify_all();
+
+    for (auto& worker : _workers) {
+        worker->wait();
+    }
+    _workers.clear();
+}
+
+void OctreeSendPool::add(OctreeSendThread* job) {
+    {
+        Lock lock(_mutex);
+        auto registration = _nextRegistration++;
+        _jobs[job] = registration;
+        _schedule.push({ usecTimestampNow(), registration, job });
+    }
+    _workerCondition.notify_one();
+}
+
+void OctreeSendPool::remove(OctreeSendThread* job) {
+    Lock lock(_mutex);
+
+    // any entry left in the schedule for this job is dropped when a worker reaches it
+    _jobs.erase(job);
+    _passDoneCondition.wait(lock, [&] {
+        return _running.find(job) == _running.end();
+    });
+}
+
+int OctreeSendPool::numJobs() {
+    Lock lock(_mutex);
+    return (int)_jobs.size();
+}
+
+float OctreeSendPool::getAverageLatenessUsecs() const {
+    quint64 totalPasses = _totalPasses;
+    return totalPasses > 0 ? (float)_totalLatenessUsecs / (float)totalPasses : 0.0f;
+}
+
+bool OctreeSendPool::next(ScheduledJob& scheduled) {
+    Lock lock(_mutex);
+    while (!_stop) {
+        if (_schedule.empty()) {
+            _workerCondition.wait(lock);
+            continue;
+        }
+
+        const auto& top = _schedule.top();
+        auto it = _jobs.find(top.job);
+        if (it == _jobs.end() || it->second != top.registration) {
+            // this job was removed since it was scheduled
+            _schedule.pop();
+            continue;
+        }
+
+        quint64 now = usecTimestampNow();
+        if (top.deadline > now) {
+            // sleep until the earliest deadline, or until an earlier job is scheduled
+            _workerCondition.wait_for(lock, std::chrono::microseconds(top.deadline - now));
+            continue;
+        }
+
+        scheduled = top;
+        _schedule.pop();
+        _running.insert(scheduled.job);
+
+        quint64 lateness = now - scheduled.deadline;
+        ++_totalPasses;
+        _totalLatenessUsecs += lateness;
+        if (lateness > LATE_PASS_THRESHOLD_USECS) {
+            ++_latePasses;
+        }
+        return true;
+    }
+    return false;
+}
+
+void OctreeSendPool::done(const ScheduledJob& scheduled, quint64 passStart, bool keepRunning) {
+    bool rescheduled = false;
+    {
+        Lock lock(_mutex);
+        assert(_running.find(scheduled.job) != _running.end());
+
+        auto it = _jobs.find(scheduled.job);
+        bool registered = it != _jobs.end() && it->second == scheduled.registration;
+        if (registered && keepRunning) {
+            _schedule.push({ passStart + OCTREE_SEND_INTERVAL_USECS, scheduled.registration, scheduled.job });
+            rescheduled = true;
+        } else if (registered) {
+            _jobs.erase(it);
+
+            // let the owner know this job is done, like a threaded GenericThread would when it exits.
+            // This is a queued signal, and emitting it while the job is still marked running
+            // keeps the owner from destroying the job under us
+            emit scheduled.job->finished();
+        }
+
+        _running.erase(scheduled.job);
+    }
+
+    if (rescheduled) {
+        _workerCondition.notify_one();
+    }
+    _passDoneCondition.notify_all();
+}
@@ -0,0 +1,103 @@
+//
+//  OctreeSendPool.h
+//  assignment-client/src/octree
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendPool_h
+#define hifi_OctreeSendPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QThread>
+
+class OctreeSendThread;
+class OctreeSendPool;
+
+class OctreeSendWorker : public QThread {
+    Q_OBJECT
+public:
+    OctreeSendWorker(OctreeSendPool& pool) : _pool(pool) {}
+
+    void run() override final;
+
+private:
+    OctreeSendPool& _pool;
+};
+
+// Fixed size pool of workers that run the send passes for all connected clients
+//   Each client keeps its OctreeSendThread (initialized non-threaded) as its send state. Workers pick the
+//   job with the earliest deadline, run a single pass (bounded by the per client and total packet budgets)
+//   and re-schedule the job one send interval after that pass started.
+//   add() and remove() must be called from the thread that owns the send threads.
+class OctreeSendPool {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
+
+public:
+    OctreeSendPool(int numThreads = QThread::idealThreadCount());
+    ~OctreeSendPool();
+
+    // schedules a pass for this job right away
+    void add(OctreeSendThread* job);
+
+    // blocks until no worker is running a pass for this job, after which it will not be run again
+    void remove(OctreeSendThread* job);
+
+    int numThreads() const { return (int)_workers.size(); }
+    int numJobs();
+
+    quint64 getTotalPasses() const { return _totalPasses; }
+    quint64 getLatePasses() const { return _latePasses; }
+    float getAverageLatenessUsecs() const;
+
+private:
+    friend class OctreeSendWorker;
+
+    struct ScheduledJob {
+        quint64 deadline { 0 };
+        uint64_t registration { 0 };
+        OctreeSendThread* job { nullptr };
+
+        bool operator>(const ScheduledJob& other) const { return deadline > other.deadline; }
+    };
+    using Schedule = std::priority_queue<ScheduledJob, std::vector<ScheduledJob>, std::greater<ScheduledJob>>;
+
+    bool next(ScheduledJob& scheduled);
+    void done(const ScheduledJob& scheduled, quint64 passStart, bool keepRunning);
+
+    std::vector<std::unique_ptr<OctreeSendWorker>> _workers;
+
+    // synchronization state
+    Mutex _mutex;
+    ConditionVariable _workerCondition;
+    ConditionVariable _passDoneCondition;
+    bool _stop { false }; // guarded by _mutex
+
+    // schedule state, guarded by _mutex
+    Schedule _schedule;
+    std::unordered_map<OctreeSendThread*, uint64_t> _jobs; // registered jobs and their registration
+    std::unordered_set<OctreeSendThread*> _running;
+    uint64_t _nextRegistration { 1 };
+
+    // stats
+    std::atomic<quint64> _totalPasses { 0 };
+    std::atomic<quint64> _latePasses { 0 };
+    std::atomic<quint64> _totalLatenessUsecs { 0 };
+};
+
+#endif // hifi_OctreeSendPool_h
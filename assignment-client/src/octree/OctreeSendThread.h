@@ -26,7 +26,7 @@ class OctreeServer;
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
-/// Threaded processor for sending octree packets to a single client
+/// Processor for sending octree packets to a single client, run by the OctreeSendPool or on its own thread
 class OctreeSendThread : public GenericThread {
     Q_OBJECT
 public:
@@ -38,6 +38,10 @@ public:
 
     QUuid getNodeUuid() const { return _nodeUuid; }
 
+    /// Runs a single send pass for this client without sleeping, returns false once this client is done.
+    /// The OctreeSendPool calls this from its workers, one pass at a time per client.
+    bool sendPass();
+
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
     static AtomicUIntStat _totalPackets;
@@ -73,7 +77,7 @@ private:
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
-    bool _isShuttingDown { false };
+    std::atomic<bool> _isShuttingDown { false };
 };
 
 #endif // hifi_OctreeSendThread_h
@@ -439,6 +439,19 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("      writeDatagram() last second: %1 clients\r\n\r\n")
             .arg(locale.toString((uint)howManyThreadsDidCallWriteDatagram(oneSecondAgo)).rightJustified(COLUMN_WIDTH, ' '));
 
+        if (_sendPool) {
+            statsString += QString("                     Send Workers: %1 threads\r\n")
+                .arg(locale.toString(_sendPool->numThreads()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("                        Send Jobs: %1 clients\r\n")
+                .arg(locale.toString(_sendPool->numJobs()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("                Total Send Passes: %1 passes\r\n")
+                .arg(locale.toString((uint)_sendPool->getTotalPasses()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("                 Late Send Passes: %1 passes\r\n")
+                .arg(locale.toString((uint)_sendPool->getLatePasses()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString().sprintf("     Average send pass lateness:    %9.2f usecs\r\n\r\n",
+                                             (double)_sendPool->getAverageLatenessUsecs());
+        }
+
         float averageLoopTime = getAverageLoopTime();
         statsString += QString().sprintf("           Average packetLoop() time:      %7.2f msecs"
                                          "                 samples: %12d \r\n",
@@ -654,6 +667,9 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 averageProcessTimePerElement = _octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         quint64 averageLockWaitTimePerElement = _octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
         quint64 totalElementsProcessed = _octreeInboundPacketProcessor->getTotalElementsProcessed();
+        quint64 totalInPlaceElementsProcessed = _octreeInboundPacketProcessor->getTotalInPlaceElementsProcessed();
+        quint64 totalHeldElementsProcessed = _octreeInboundPacketProcessor->getTotalHeldElementsProcessed();
+        quint64 totalCoalescedEdits = _tree->getTotalCoalescedEdits();
         quint64 totalPacketsProcessed = _octreeInboundPacketProcessor->getTotalPacketsProcessed();
 
         quint64 averageDecodeTime = _tree->getAverageDecodeTime();
@@ -666,6 +682,7 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         int FLOAT_PRECISION = 3;
 
         float averageElementsPerPacket = totalPacketsProcessed == 0 ? 0 : (float)totalElementsProcessed / totalPacketsProcessed;
+        float coalescedElementsRatio = totalElementsProcessed == 0 ? 0 : (float)totalCoalescedEdits / totalElementsProcessed;
 
         statsString += QString("   Current Inbound Packets Queue: %1 packets \r\n")
             .arg(locale.toString((uint)currentPacketsInQueue).rightJustified(COLUMN_WIDTH, ' '));
@@ -678,6 +695,14 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             .arg(locale.toString((uint)totalPacketsProcessed).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("          Total Inbound Elements: %1 elements\r\n")
             .arg(locale.toString((uint)totalElementsProcessed).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString(" Total Inbound Elements In Place: %1 elements\r\n")
+            .arg(locale.toString((uint)totalInPlaceElementsProcessed).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("     Total Inbound Elements Held: %1 elements\r\n")
+            .arg(locale.toString((uint)totalHeldElementsProcessed).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("Total Inbound Elements Coalesced: %1 elements\r\n")
+            .arg(locale.toString((uint)totalCoalescedEdits).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString().sprintf("     Inbound Elements Coalesced: %5.2f%%\r\n",
+                                         (double)(coalescedElementsRatio * 100.0f));
         statsString += QString().sprintf(" Average Inbound Elements/Packet: %f elements/packet\r\n",
                                          (double)averageElementsPerPacket);
         statsString += QString("     Average Transit Time/Packet: %1 usecs\r\n")
@@ -876,9 +901,12 @@ void OctreeServer::parsePayload() {
 OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePointer& node) {
     auto sendThread = newSendThread(node);
 
-    // we want to be notified when the thread finishes
+    // we want to be notified when the send pool is done with this client
     connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+
+    // send passes are run by the send pool workers rather than a thread per client
+    sendThread->initialize(false);
+    _sendPool->add(sendThread.get());
 
     return sendThread;
 }
@@ -886,13 +914,19 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
+        auto it = _sendThreads.find(sendThread->getNodeUuid());
+        if (it == _sendThreads.end() || it->second.get() != sendThread) {
+            return;
+        }
+
         // This deletes the unique_ptr, so sendThread is destructed after that line
-        _sendThreads.erase(sendThread->getNodeUuid());
+        _sendPool->remove(sendThread);
+        _sendThreads.erase(it);
     }
 }
 
 void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    if (!_isFinished && !_isShuttingDown) {
+    if (!_isFinished && !_isShuttingDown && _sendPool) {
         // If we got a query packet, then we're talking to an agent, and we
         // need to make sure we have it in our nodeList.
         auto nodeList = DependencyManager::get<NodeList>();
@@ -902,7 +936,8 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
-            _sendThreads.erase(it); // Remove right away and wait on thread to be
+            _sendPool->remove(it->second.get()); // Remove right away, waiting on any pass in progress
+            _sendThreads.erase(it);
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         }
@@ -1096,6 +1131,13 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    // Check to see if the user passed in a number of workers for the send pool
+    readOptionInt(QString("sendWorkers"), settingsSectionObject, _numSendWorkers);
+    if (_numSendWorkers <= 0) {
+        _numSendWorkers = QThread::idealThreadCount();
+    }
+    qDebug("sendWorkers=%d", _numSendWorkers);
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1128,6 +1170,8 @@ void OctreeServer::domainSettingsRequestComplete() {
 
     readConfiguration();
 
+    _sendPool.reset(new OctreeSendPool(_numSendWorkers));
+
     // if we want Persistence, set up the local file and persist thread
     if (_wantPersist) {
         static const QString ENTITY_PERSIST_EXTENSION = ".json.gz";
@@ -1293,8 +1337,8 @@ void OctreeServer::aboutToFinish() {
         sendThread.setIsShuttingDown();
     }
 
-    // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
-    // which waits on the thread to be done before returning
+    // Stop the send pool, which waits on any pass in progress, before the send threads it runs are destructed
+    _sendPool.reset();
     _sendThreads.clear(); // Cleans up all the send threads.
 
     if (_persistManager) {
@@ -1411,6 +1455,12 @@ void OctreeServer::sendStatsPacket() {
     threadsStats["2. packetDistributor"] = (double)howManyThreadsDidPacketDistributor(oneSecondAgo);
     threadsStats["3. handlePacektSend"] = (double)howManyThreadsDidHandlePacketSend(oneSecondAgo);
     threadsStats["4. writeDatagram"] = (double)howManyThreadsDidCallWriteDatagram(oneSecondAgo);
+    if (_sendPool) {
+        threadsStats["5. sendWorkers"] = _sendPool->numThreads();
+        threadsStats["6. sendPasses"] = (double)_sendPool->getTotalPasses();
+        threadsStats["7. lateSendPasses"] = (double)_sendPool->getLatePasses();
+        threadsStats["8. avgSendPassLateness"] = (double)_sendPool->getAverageLatenessUsecs();
+    }
 
     QJsonObject statsArray1;
     statsArray1["1. configuration"] = getConfiguration();
@@ -1456,6 +1506,9 @@ void OctreeServer::sendStatsPacket() {
         dataArray2["1. packetQueue"] = (double)_octreeInboundPacketProcessor->packetsToProcessCount();
         dataArray2["2. totalPackets"] = (double)_octreeInboundPacketProcessor->getTotalPacketsProcessed();
         dataArray2["3. totalElements"] = (double)_octreeInboundPacketProcessor->getTotalElementsProcessed();
+        dataArray2["4. totalInPlaceElements"] = (double)_octreeInboundPacketProcessor->getTotalInPlaceElementsProcessed();
+        dataArray2["5. totalHeldElements"] = (double)_octreeInboundPacketProcessor->getTotalHeldElementsProcessed();
+        dataArray2["6. totalCoalescedElements"] = (double)_tree->getTotalCoalescedEdits();
 
         timingArray2["1. avgTransitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageTransitTimePerPacket();
         timingArray2["2. avgProcessTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerPacket();
@@ -23,6 +23,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendPool.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -202,6 +203,8 @@ protected:
     QString _safeServerName;
     
     SendThreads _sendThreads;
+    std::unique_ptr<OctreeSendPool> _sendPool;
+    int _numSendWorkers { 0 }; // zero uses the ideal thread count
 
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
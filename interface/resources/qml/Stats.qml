@@ -119,6 +119,14 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar tiers full/reduced/transform: " +
+                                    root.avatarTierCounts.x + "/" + root.avatarTierCounts.y + "/" + root.avatarTierCounts.z + " (" +
+                                    root.avatarTierSimulationTimes.x.toFixed(2) + "/" +
+                                    root.avatarTierSimulationTimes.y.toFixed(2) + "/" +
+                                    root.avatarTierSimulationTimes.z.toFixed(2) + " ms)"
+                    }
                     StatText {
                         visible: root.expanded
                         text: "Total picks:\n    " +
@@ -255,6 +255,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     uint64_t updateExpiry = startTime + MAX_UPDATE_AVATARS_TIME_BUDGET;
     int numAvatarsUpdated = 0;
     int numAVatarsNotUpdated = 0;
+    std::array<uint64_t, OtherAvatar::NUM_UPDATE_TIERS> tierSimulationTimes {};
+    std::array<int, OtherAvatar::NUM_UPDATE_TIERS> tierAvatarCounts {};
 
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
@@ -285,7 +287,12 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         if (now < updateExpiry) {
             // we're within budget
             bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
-            if (inView && avatar->hasNewJointData()) {
+
+            // the workload region decides how much of this avatar we simulate,
+            // when its joints are skipped only the transform and bounds of its model are updated
+            auto tier = avatar->getUpdateTier();
+            bool simulateJoints = inView && avatar->shouldSimulateJoints(tier, now);
+            if (simulateJoints && avatar->hasNewJointData()) {
                 numAvatarsUpdated++;
             }
             auto transitStatus = avatar->_transit.update(deltaTime, avatar->_serverPosition, _transitConfig);
@@ -293,10 +300,18 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                 avatar->_transit.reset();
                 avatar->setIsNewAvatar(false);
             }
-            avatar->simulate(deltaTime, inView);
+            avatar->simulate(deltaTime, simulateJoints);
+            if (simulateJoints && avatar->getSkeletonModel()->isLoaded() && !avatar->hasNewJointData()) {
+                // only count joints that made it onto a loaded skeleton, a far avatar whose model
+                // loads after its last joint update still needs to be posed
+                avatar->_lastJointSimulationTime = now;
+            }
             avatar->updateRenderItem(renderTransaction);
             avatar->updateSpaceProxy(workloadTransaction);
             avatar->setLastRenderUpdateTime(startTime);
+
+            tierSimulationTimes[tier] += usecTimestampNow() - now;
+            ++tierAvatarCounts[tier];
         } else {
             // we've spent our full time budget --> bail on the rest of the avatar updates
             // --> more avatars may freeze until their priority trickles up
@@ -332,6 +347,10 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAVatarsNotUpdated;
+    for (int i = 0; i < OtherAvatar::NUM_UPDATE_TIERS; ++i) {
+        _tierSimulationTimes[i] = (float)tierSimulationTimes[i] / (float)USECS_PER_MSEC;
+        _tierAvatarCounts[i] = tierAvatarCounts[i];
+    }
 
     simulateAvatarFades(deltaTime);
 
@@ -12,6 +12,7 @@
 #ifndef hifi_AvatarManager_h
 #define hifi_AvatarManager_h
 
+#include <array>
 #include <set>
 
 #include <QtCore/QHash>
@@ -89,6 +90,8 @@ public:
     int getNumAvatarsUpdated() const { return _numAvatarsUpdated; }
     int getNumAvatarsNotUpdated() const { return _numAvatarsNotUpdated; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
+    float getAvatarTierSimulationTime(OtherAvatar::UpdateTier tier) const { return _tierSimulationTimes[tier]; }
+    int getNumAvatarsInTier(OtherAvatar::UpdateTier tier) const { return _tierAvatarCounts[tier]; }
 
     void updateMyAvatar(float deltaTime);
     void updateOtherAvatars(float deltaTime);
@@ -237,6 +240,8 @@ private:
     int _numAvatarsUpdated { 0 };
     int _numAvatarsNotUpdated { 0 };
     float _avatarSimulationTime { 0.0f };
+    std::array<float, OtherAvatar::NUM_UPDATE_TIERS> _tierSimulationTimes {};
+    std::array<int, OtherAvatar::NUM_UPDATE_TIERS> _tierAvatarCounts {};
     bool _shouldRender { true };
     bool _myAvatarDataPacketsPaused { false };
     mutable int _identityRequestsSent { 0 };
@@ -857,6 +857,7 @@ void MyAvatar::simulate(float deltaTime) {
         if (_rigEnabled) {
             QWriteLocker writeLock(&_jointDataLock);
             _skeletonModel->getRig().copyJointsIntoJointData(_jointData);
+            markJointDataChanged();
         }
     }
 
@@ -115,6 +115,33 @@ void OtherAvatar::setWorkloadRegion(uint8_t region) {
     _workloadRegion = region;
 }
 
+OtherAvatar::UpdateTier OtherAvatar::getUpdateTier() const {
+    switch (_workloadRegion) {
+        case workload::Region::R1:
+        case workload::Region::INVALID: // not classified by the workload yet, don't degrade it
+            return FULL_UPDATE;
+        case workload::Region::R2:
+            return REDUCED_UPDATE;
+        default:
+            return TRANSFORM_UPDATE;
+    }
+}
+
+bool OtherAvatar::shouldSimulateJoints(UpdateTier tier, uint64_t now) const {
+    // mid-range avatars replay their last pose between joint updates
+    const uint64_t REDUCED_UPDATE_JOINT_INTERVAL = USECS_PER_SECOND / 15;
+
+    switch (tier) {
+        case FULL_UPDATE:
+            return true;
+        case REDUCED_UPDATE:
+            return now - _lastJointSimulationTime >= REDUCED_UPDATE_JOINT_INTERVAL;
+        default:
+            // far avatars still get one pose so they aren't left in bind pose
+            return _lastJointSimulationTime == 0;
+    }
+}
+
 bool OtherAvatar::shouldBeInPhysicsSimulation() const {
     return (_workloadRegion < workload::Region::R3 && !isDead());
 }
@@ -23,6 +23,14 @@ class AvatarMotionState;
 
 class OtherAvatar : public Avatar {
 public:
+    // How much of an avatar is simulated each frame, picked from the workload region it is in
+    enum UpdateTier : uint8_t {
+        FULL_UPDATE = 0,  // joints, rig and skinning every frame
+        REDUCED_UPDATE,   // joints at a reduced rate, the last pose is held in between
+        TRANSFORM_UPDATE, // model transform and bounds only
+        NUM_UPDATE_TIERS
+    };
+
     explicit OtherAvatar(QThread* thread);
     virtual ~OtherAvatar();
 
@@ -42,6 +50,8 @@ public:
     void rebuildCollisionShape() override;
 
     void setWorkloadRegion(uint8_t region);
+    UpdateTier getUpdateTier() const;
+    bool shouldSimulateJoints(UpdateTier tier, uint64_t now) const;
     bool shouldBeInPhysicsSimulation() const;
     bool needsPhysicsUpdate() const;
 
@@ -53,6 +63,7 @@ protected:
     AvatarMotionState* _motionState { nullptr };
     int32_t _spaceIndex { -1 };
     uint8_t _workloadRegion { workload::Region::INVALID };
+    uint64_t _lastJointSimulationTime { 0 };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
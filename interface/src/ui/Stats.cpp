@@ -365,6 +365,12 @@ void Stats::updateStats(bool force) {
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    STAT_UPDATE(avatarTierSimulationTimes, QVector3D(avatarManager->getAvatarTierSimulationTime(OtherAvatar::FULL_UPDATE),
+                                                     avatarManager->getAvatarTierSimulationTime(OtherAvatar::REDUCED_UPDATE),
+                                                     avatarManager->getAvatarTierSimulationTime(OtherAvatar::TRANSFORM_UPDATE)));
+    STAT_UPDATE(avatarTierCounts, QVector3D(avatarManager->getNumAvatarsInTier(OtherAvatar::FULL_UPDATE),
+                                            avatarManager->getNumAvatarsInTier(OtherAvatar::REDUCED_UPDATE),
+                                            avatarManager->getNumAvatarsInTier(OtherAvatar::TRANSFORM_UPDATE)));
 
     if (_expanded) {
         STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
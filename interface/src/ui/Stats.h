@@ -134,6 +134,9 @@ private: \
  * @property {number} batchFrameTime - <em>Read-only.</em>
  * @property {number} engineFrameTime - <em>Read-only.</em>
  * @property {number} avatarSimulationTime - <em>Read-only.</em>
+ * @property {Vec3} avatarTierSimulationTimes - <em>Read-only.</em> Milliseconds spent last frame simulating avatars in the full,
+ *     reduced and transform-only update tiers, as <code>x</code>, <code>y</code> and <code>z</code>.
+ * @property {Vec3} avatarTierCounts - <em>Read-only.</em> Number of avatars simulated last frame in each update tier.
  *
  *
  * @property {number} x
@@ -291,6 +294,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(QVector3D, avatarTierSimulationTimes, QVector3D(0, 0, 0))
+    STATS_PROPERTY(QVector3D, avatarTierCounts, QVector3D(0, 0, 0))
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -1025,6 +1030,20 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>avatarTierSimulationTimes</code> property changes.
+     * @function Stats.avatarTierSimulationTimesChanged
+     * @returns {Signal}
+     */
+    void avatarTierSimulationTimesChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>avatarTierCounts</code> property changes.
+     * @function Stats.avatarTierCountsChanged
+     * @returns {Signal}
+     */
+    void avatarTierCountsChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>rectifiedTextureCount</code> property changes.
      * @function Stats.rectifiedTextureCountChanged
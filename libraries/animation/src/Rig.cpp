@@ -1994,18 +1994,18 @@ void Rig::copyJointsIntoJointData(QVector<JointData>& jointDataVec) const {
     }
 }
 
-void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
+bool Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
     DETAILED_PROFILE_RANGE(simulation_animation_detail, "copyJoints");
     DETAILED_PERFORMANCE_TIMER("copyJoints");
 
     if (!_animSkeleton) {
-        return;
+        return false;
     }
     int numJoints = jointDataVec.size();
     const AnimPoseVec& absoluteDefaultPoses = _animSkeleton->getAbsoluteDefaultPoses();
     if (numJoints != (int)absoluteDefaultPoses.size()) {
         // jointData is incompatible
-        return;
+        return true;
     }
 
     // make a vector of rotations in absolute-model-frame
@@ -2040,6 +2040,7 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
             _internalPoseSet._relativePoses[i].trans() = _invGeometryOffset.scale() * data.translation;
         }
     }
+    return true;
 }
 
 void Rig::computeExternalPoses(const glm::mat4& modelOffsetMat) {
@@ -209,7 +209,8 @@ public:
     bool getRelativeDefaultJointTranslation(int index, glm::vec3& translationOut) const;
 
     void copyJointsIntoJointData(QVector<JointData>& jointDataVec) const;
-    void copyJointsFromJointData(const QVector<JointData>& jointDataVec);
+    // returns false if there is no skeleton yet to copy the joints into
+    bool copyJointsFromJointData(const QVector<JointData>& jointDataVec);
     void computeExternalPoses(const glm::mat4& modelOffsetMat);
 
     void computeAvatarBoundingCapsule(const HFMModel& hfmModel, float& radiusOut, float& heightOut, glm::vec3& offsetOut) const;
@@ -385,10 +385,19 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         parentID = getParentID();
     }
 
+    // the snapshot is shared by every listener this version of the joints is encoded for,
+    // detail levels that don't send joints leave any pending joint sections undecoded
+    JointDataSnapshotPointer jointData;
+    if (wantedFlags & (AvatarDataPacket::PACKET_HAS_JOINT_DATA | AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS)) {
+        jointData = getJointDataSnapshot();
+    }
+    const int numJoints = jointData ? jointData->size() : 0;
+    assert(numJoints <= 255);
+
     const size_t byteArraySize = AvatarDataPacket::MAX_CONSTANT_HEADER_SIZE + NUM_BYTES_RFC4122_UUID +
          AvatarDataPacket::maxFaceTrackerInfoSize(_headData->getBlendshapeCoefficients().size()) +
-         AvatarDataPacket::maxJointDataSize(_jointData.size(), true) +
-         AvatarDataPacket::maxJointDefaultPoseFlagsSize(_jointData.size());
+         AvatarDataPacket::maxJointDataSize(numJoints, true) +
+         AvatarDataPacket::maxJointDefaultPoseFlagsSize(numJoints);
 
     if (maxDataSize == 0) {
         maxDataSize = (int)byteArraySize;
@@ -598,13 +607,6 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         }
     }
 
-    QVector<JointData> jointData;
-    if (wantedFlags & (AvatarDataPacket::PACKET_HAS_JOINT_DATA | AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS)) {
-        QReadLocker readLock(&_jointDataLock);
-        jointData = _jointData;
-    }
-    const int numJoints = jointData.size();
-    assert(numJoints <= 255);
     const int jointBitVectorSize = calcBitVectorSize(numJoints);
 
     // Start joints if room for at least the faux joints.
@@ -631,30 +633,33 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         if (sentJointDataOut) {
             sentJointDataOut->resize(numJoints); // Make sure the destination is resized before using it
         }
-        const JointData *const joints = jointData.data();
+        const glm::quat* const rotations = jointData->rotations.data();
+        const glm::vec3* const translations = jointData->translations.data();
+        const uint8_t* const rotationIsDefaultPose = jointData->rotationIsDefaultPose.data();
+        const uint8_t* const translationIsDefaultPose = jointData->translationIsDefaultPose.data();
         JointData *const sentJoints = sentJointDataOut ? sentJointDataOut->data() : nullptr;
 
         float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
 
         int i = sendStatus.rotationsSent;
         for (; i < numJoints; ++i) {
-            const JointData& data = joints[i];
+            const glm::quat& rotation = rotations[i];
             const JointData& last = lastSentJointData[i];
 
             if (packetEnd - destinationBuffer >= minSizeForJoint) {
-                if (!data.rotationIsDefaultPose) {
+                if (!rotationIsDefaultPose[i]) {
                     // The dot product for larger rotations is a lower number,
                     // so if the dot() is less than the value, then the rotation is a larger angle of rotation
-                    if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != data.rotation)
-                        || (cullSmallChanges && fabsf(glm::dot(last.rotation, data.rotation)) < minRotationDOT)) {
+                    if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != rotation)
+                        || (cullSmallChanges && fabsf(glm::dot(last.rotation, rotation)) < minRotationDOT)) {
                         validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
 #ifdef WANT_DEBUG
                         rotationSentCount++;
 #endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, rotation);
 
                         if (sentJoints) {
-                            sentJoints[i].rotation = data.rotation;
+                            sentJoints[i].rotation = rotation;
                         }
                     }
                 }
@@ -663,7 +668,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             }
 
             if (sentJoints) {
-                sentJoints[i].rotationIsDefaultPose = data.rotationIsDefaultPose;
+                sentJoints[i].rotationIsDefaultPose = rotationIsDefaultPose[i];
             }
 
         }
@@ -685,26 +690,26 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         float maxTranslationDimension = 0.0;
         i = sendStatus.translationsSent;
         for (; i < numJoints; ++i) {
-            const JointData& data = joints[i];
+            const glm::vec3& translation = translations[i];
             const JointData& last = lastSentJointData[i];
 
             if (packetEnd - destinationBuffer >= minSizeForJoint) {
-                if (!data.translationIsDefaultPose) {
-                    if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
-                        || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
+                if (!translationIsDefaultPose[i]) {
+                    if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != translation)
+                        || (cullSmallChanges && glm::distance(translation, last.translation) > minTranslation)) {
                         validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
 #ifdef WANT_DEBUG
                         translationSentCount++;
 #endif
-                        maxTranslationDimension = glm::max(fabsf(data.translation.x), maxTranslationDimension);
-                        maxTranslationDimension = glm::max(fabsf(data.translation.y), maxTranslationDimension);
-                        maxTranslationDimension = glm::max(fabsf(data.translation.z), maxTranslationDimension);
+                        maxTranslationDimension = glm::max(fabsf(translation.x), maxTranslationDimension);
+                        maxTranslationDimension = glm::max(fabsf(translation.y), maxTranslationDimension);
+                        maxTranslationDimension = glm::max(fabsf(translation.z), maxTranslationDimension);
 
                         destinationBuffer +=
-                            packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+                            packFloatVec3ToSignedTwoByteFixed(destinationBuffer, translation, TRANSLATION_COMPRESSION_RADIX);
 
                         if (sentJoints) {
-                            sentJoints[i].translation = data.translation;
+                            sentJoints[i].translation = translation;
                         }
                     }
                 }
@@ -713,7 +718,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             }
 
             if (sentJoints) {
-                sentJoints[i].translationIsDefaultPose = data.translationIsDefaultPose;
+                sentJoints[i].translationIsDefaultPose = translationIsDefaultPose[i];
             }
 
         }
@@ -790,12 +795,12 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         // write rotationIsDefaultPose bits
         destinationBuffer += writeBitVector(destinationBuffer, numJoints, [&](int i) {
-            return jointData[i].rotationIsDefaultPose;
+            return (bool)jointData->rotationIsDefaultPose[i];
         });
 
         // write translationIsDefaultPose bits
         destinationBuffer += writeBitVector(destinationBuffer, numJoints, [&](int i) {
-            return jointData[i].translationIsDefaultPose;
+            return (bool)jointData->translationIsDefaultPose[i];
         });
 
         if (outboundDataRateOut) {
@@ -824,6 +829,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 // NOTE: This is never used in a "distanceAdjust" mode, so it's ok that it doesn't use a variable minimum rotation/translation
 void AvatarData::doneEncoding(bool cullSmallChanges) {
     // The server has finished sending this version of the joint-data to other nodes.  Update _lastSentJointData.
+    decodePendingJointData();
     QReadLocker readLock(&_jointDataLock);
     _lastSentJointData.resize(_jointData.size());
     for (int i = 0; i < _jointData.size(); i ++) {
@@ -875,6 +881,267 @@ const unsigned char* unpackFauxJoint(const unsigned char* sourceBuffer, ThreadSa
 }
 
 
+// count the set bits in the first numJoints bits of a validity bit vector
+static int countValidityBits(const unsigned char* sourceBuffer, int numJoints) {
+    int numValid = 0;
+    for (int i = 0; i < numJoints; i++) {
+        if (sourceBuffer[i / BITS_IN_BYTE] & (1 << (i % BITS_IN_BYTE))) {
+            ++numValid;
+        }
+    }
+    return numValid;
+}
+
+// decode a joint section whose size has already been checked by parseDataFromBuffer, caller must hold _jointDataLock
+int AvatarData::decodeJointSection(const unsigned char* sourceBuffer) const {
+    const unsigned char* startSection = sourceBuffer;
+
+    int numJoints = *sourceBuffer++;
+    const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
+
+    const unsigned char* rotationValidity = sourceBuffer;
+    sourceBuffer += bytesOfValidity;
+
+    _jointData.resize(numJoints);
+
+    for (int i = 0; i < numJoints; i++) {
+        if (rotationValidity[i / BITS_IN_BYTE] & (1 << (i % BITS_IN_BYTE))) {
+            JointData& data = _jointData[i];
+            sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+            _hasNewJointData = true;
+            data.rotationIsDefaultPose = false;
+        }
+    }
+
+    const unsigned char* translationValidity = sourceBuffer;
+    sourceBuffer += bytesOfValidity;
+
+    for (int i = 0; i < numJoints; i++) {
+        if (translationValidity[i / BITS_IN_BYTE] & (1 << (i % BITS_IN_BYTE))) {
+            JointData& data = _jointData[i];
+            sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+            _hasNewJointData = true;
+            data.translationIsDefaultPose = false;
+        }
+    }
+
+    markJointDataChanged();
+    return sourceBuffer - startSection;
+}
+
+// decode default pose flags whose size has already been checked by parseDataFromBuffer, caller must hold _jointDataLock
+int AvatarData::decodeJointDefaultPoseFlags(const unsigned char* sourceBuffer) const {
+    const unsigned char* startSection = sourceBuffer;
+
+    int numJoints = (int)*sourceBuffer++;
+
+    _jointData.resize(numJoints);
+
+    sourceBuffer += readBitVector(sourceBuffer, numJoints, [&](int i, bool value) {
+        _jointData[i].rotationIsDefaultPose = value;
+    });
+
+    sourceBuffer += readBitVector(sourceBuffer, numJoints, [&](int i, bool value) {
+        _jointData[i].translationIsDefaultPose = value;
+    });
+
+    markJointDataChanged();
+    return sourceBuffer - startSection;
+}
+
+// each packed joint rotation and translation is stored in 6 bytes
+static const int COMPRESSED_JOINT_VALUE_SIZE = 6;
+
+static int jointValidityBytes(int numJoints) {
+    return (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
+}
+
+// merge a packed joint section into one for the same joints received before it,
+// keeping the newest value of each joint either carries
+static QByteArray mergeJointSections(const QByteArray& olderSection, const QByteArray& newerSection) {
+    const unsigned char* older = reinterpret_cast<const unsigned char*>(olderSection.constData());
+    const unsigned char* newer = reinterpret_cast<const unsigned char*>(newerSection.constData());
+
+    const int numJoints = *older++;
+    newer++;
+    const int bytesOfValidity = jointValidityBytes(numJoints);
+
+    // enough room for every joint to be valid, trimmed once we know how many are
+    QByteArray mergedSection(1 + 2 * (bytesOfValidity + numJoints * COMPRESSED_JOINT_VALUE_SIZE), 0);
+    unsigned char* const startSection = reinterpret_cast<unsigned char*>(mergedSection.data());
+    unsigned char* destination = startSection;
+    *destination++ = (unsigned char)numJoints;
+
+    // the rotations and the translations that follow them share the same layout
+    for (int part = 0; part < 2; ++part) {
+        const unsigned char* olderValidity = older;
+        older += bytesOfValidity;
+        const unsigned char* newerValidity = newer;
+        newer += bytesOfValidity;
+        unsigned char* validity = destination;
+        destination += bytesOfValidity;
+
+        for (int i = 0; i < numJoints; ++i) {
+            const int byte = i / BITS_IN_BYTE;
+            const unsigned char bit = 1 << (i % BITS_IN_BYTE);
+            const bool inOlder = olderValidity[byte] & bit;
+            const bool inNewer = newerValidity[byte] & bit;
+
+            if (inNewer || inOlder) {
+                memcpy(destination, inNewer ? newer : older, COMPRESSED_JOINT_VALUE_SIZE);
+                destination += COMPRESSED_JOINT_VALUE_SIZE;
+                validity[byte] |= bit;
+            }
+            if (inOlder) {
+                older += COMPRESSED_JOINT_VALUE_SIZE;
+            }
+            if (inNewer) {
+                newer += COMPRESSED_JOINT_VALUE_SIZE;
+            }
+        }
+    }
+
+    mergedSection.resize((int)(destination - startSection));
+    return mergedSection;
+}
+
+// decoding a joint section marks the joints it carries as not in their default pose, so default pose flags
+// received before it must lose those bits to be applied after it
+static void clearDefaultPoseFlags(QByteArray& flagsSection, const QByteArray& jointSection) {
+    unsigned char* flags = reinterpret_cast<unsigned char*>(flagsSection.data());
+    const unsigned char* joints = reinterpret_cast<const unsigned char*>(jointSection.constData());
+
+    const int numJoints = *flags++;
+    joints++;
+
+    unsigned char* rotationFlags = flags;
+    unsigned char* translationFlags = flags + calcBitVectorSize(numJoints);
+
+    const int bytesOfValidity = jointValidityBytes(numJoints);
+    const unsigned char* rotationValidity = joints;
+    const unsigned char* translationValidity = rotationValidity + bytesOfValidity +
+        countValidityBits(rotationValidity, numJoints) * COMPRESSED_JOINT_VALUE_SIZE;
+
+    for (int i = 0; i < numJoints; ++i) {
+        const int byte = i / BITS_IN_BYTE;
+        const unsigned char bit = 1 << (i % BITS_IN_BYTE);
+        if (rotationValidity[byte] & bit) {
+            rotationFlags[byte] &= ~bit;
+        }
+        if (translationValidity[byte] & bit) {
+            translationFlags[byte] &= ~bit;
+        }
+    }
+}
+
+// packed sections can only be merged if they all describe the same number of joints
+static bool haveSameJointCount(std::initializer_list<const QByteArray*> sections) {
+    int numJoints = -1;
+    for (auto section : sections) {
+        if (section->isEmpty()) {
+            continue;
+        }
+        int sectionJoints = (unsigned char)section->at(0);
+        if (numJoints != -1 && sectionJoints != numJoints) {
+            return false;
+        }
+        numJoints = sectionJoints;
+    }
+    return true;
+}
+
+// caller must hold _jointDataLock for writing
+void AvatarData::queuePendingJointData(PendingJointData& pendingJointData) {
+    if (_hasPendingJointData && !haveSameJointCount({ &_pendingJointData.joints, &_pendingJointData.defaultPoseFlags,
+                                                      &pendingJointData.joints, &pendingJointData.defaultPoseFlags })) {
+        // a new skeleton changes the joint count between sections, apply what is waiting before queueing these
+        applyPendingJointData();
+    }
+
+    if (!_hasPendingJointData) {
+        _pendingJointData = std::move(pendingJointData);
+        _hasPendingJointData = true;
+        return;
+    }
+
+    // fold the new sections into the waiting ones, so an avatar nobody asks about keeps one packet's worth
+    PendingJointData& pending = _pendingJointData;
+    if (!pendingJointData.joints.isEmpty()) {
+        if (!pending.defaultPoseFlags.isEmpty() && pendingJointData.defaultPoseFlags.isEmpty()) {
+            clearDefaultPoseFlags(pending.defaultPoseFlags, pendingJointData.joints);
+        }
+        if (pending.joints.isEmpty()) {
+            pending.joints = std::move(pendingJointData.joints);
+        } else {
+            pending.joints = mergeJointSections(pending.joints, pendingJointData.joints);
+        }
+    }
+
+    // default pose flags carry every joint, so the newest ones replace the rest
+    if (!pendingJointData.defaultPoseFlags.isEmpty()) {
+        pending.defaultPoseFlags = std::move(pendingJointData.defaultPoseFlags);
+    }
+}
+
+// caller must hold _jointDataLock for writing
+void AvatarData::applyPendingJointData() const {
+    // the flags are applied after the joints they arrived with, as they were received
+    if (!_pendingJointData.joints.isEmpty()) {
+        decodeJointSection(reinterpret_cast<const unsigned char*>(_pendingJointData.joints.constData()));
+    }
+    if (!_pendingJointData.defaultPoseFlags.isEmpty()) {
+        decodeJointDefaultPoseFlags(reinterpret_cast<const unsigned char*>(_pendingJointData.defaultPoseFlags.constData()));
+    }
+
+    _pendingJointData = PendingJointData();
+    _hasPendingJointData = false;
+}
+
+void AvatarData::decodePendingJointData() const {
+    if (!_hasPendingJointData) {
+        return;
+    }
+
+    QWriteLocker writeLock(&_jointDataLock);
+    if (_hasPendingJointData) {
+        applyPendingJointData();
+    }
+}
+
+JointDataSnapshotPointer AvatarData::getJointDataSnapshot() const {
+    decodePendingJointData();
+
+    std::lock_guard<std::mutex> lock(_jointDataSnapshotMutex);
+    if (_jointDataSnapshot && _jointDataSnapshot->version == _jointDataVersion) {
+        return _jointDataSnapshot;
+    }
+
+    // nobody else is holding the last snapshot, so its arrays can be refilled in place
+    if (!_jointDataSnapshot || _jointDataSnapshot.use_count() > 1) {
+        _jointDataSnapshot = std::make_shared<JointDataSnapshot>();
+    }
+
+    QReadLocker readLock(&_jointDataLock);
+    // read the version under the joint lock, a write that lands after this bumps it again
+    _jointDataSnapshot->version = _jointDataVersion;
+
+    const int numJoints = _jointData.size();
+    _jointDataSnapshot->resize(numJoints);
+    const JointData* joints = _jointData.constData();
+    for (int i = 0; i < numJoints; ++i) {
+        _jointDataSnapshot->set(i, joints[i]);
+    }
+
+    return _jointDataSnapshot;
+}
+
+void AvatarData::setLazyJointDecoding(bool lazyJointDecoding) {
+    if (!lazyJointDecoding) {
+        decodePendingJointData();
+    }
+    _lazyJointDecoding = lazyJointDecoding;
+}
+
 #define PACKET_READ_CHECK(ITEM_NAME, SIZE_TO_READ)                                        \
     if ((endPosition - sourceBuffer) < (int)SIZE_TO_READ) {                               \
         if (shouldLogError(now)) {                                                        \
@@ -900,6 +1167,9 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     memcpy(&packetStateFlags, sourceBuffer, sizeof(packetStateFlags));
     sourceBuffer += sizeof(packetStateFlags);
 
+    // joint sections that are only decoded on demand (see setLazyJointDecoding)
+    PendingJointData pendingJointData;
+
     #define HAS_FLAG(B,F) ((B & F) == F)
 
     bool hasAvatarGlobalPosition  = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION);
@@ -1217,73 +1487,32 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
         PACKET_READ_CHECK(JointRotationValidityBits, bytesOfValidity);
 
-        int numValidJointRotations = 0;
-        QVector<bool> validRotations;
-        validRotations.resize(numJoints);
-        { // rotation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
-            for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
-                }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointRotations;
-                }
-                validRotations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
-            }
-        }
+        // the rotation validity bits tell us how many rotations were packed
+        int numValidJointRotations = countValidityBits(sourceBuffer, numJoints);
+        sourceBuffer += bytesOfValidity;
 
         // each joint rotation is stored in 6 bytes.
-        QWriteLocker writeLock(&_jointDataLock);
-        _jointData.resize(numJoints);
-
         const int COMPRESSED_QUATERNION_SIZE = 6;
         PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
-                _hasNewJointData = true;
-                data.rotationIsDefaultPose = false;
-            }
-        }
+        sourceBuffer += numValidJointRotations * COMPRESSED_QUATERNION_SIZE;
 
         PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
 
         // get translation validity bits -- these indicate which translations were packed
-        int numValidJointTranslations = 0;
-        QVector<bool> validTranslations;
-        validTranslations.resize(numJoints);
-        { // translation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
-            for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
-                }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointTranslations;
-                }
-                validTranslations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
-            }
-        } // 1 + bytesOfValidity bytes
+        int numValidJointTranslations = countValidityBits(sourceBuffer, numJoints);
+        sourceBuffer += bytesOfValidity;
 
         // each joint translation component is stored in 6 bytes.
         const int COMPRESSED_TRANSLATION_SIZE = 6;
         PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
+        sourceBuffer += numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE;
 
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
-                _hasNewJointData = true;
-                data.translationIsDefaultPose = false;
-            }
+        if (_lazyJointDecoding) {
+            // keep the packed joints around, they are only decoded if someone asks for them
+            pendingJointData.joints = QByteArray(reinterpret_cast<const char*>(startSection), sourceBuffer - startSection);
+        } else {
+            QWriteLocker writeLock(&_jointDataLock);
+            decodeJointSection(startSection);
         }
 
 #ifdef WANT_DEBUG
@@ -1345,29 +1574,35 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     if (hasJointDefaultPoseFlags) {
         auto startSection = sourceBuffer;
 
-        QWriteLocker writeLock(&_jointDataLock);
-
         PACKET_READ_CHECK(JointDefaultPoseFlagsNumJoints, sizeof(uint8_t));
         int numJoints = (int)*sourceBuffer++;
 
-        _jointData.resize(numJoints);
-
         size_t bitVectorSize = calcBitVectorSize(numJoints);
         PACKET_READ_CHECK(JointDefaultPoseFlagsRotationFlags, bitVectorSize);
-        sourceBuffer += readBitVector(sourceBuffer, numJoints, [&](int i, bool value) {
-            _jointData[i].rotationIsDefaultPose = value;
-        });
+        sourceBuffer += bitVectorSize;
 
         PACKET_READ_CHECK(JointDefaultPoseFlagsTranslationFlags, bitVectorSize);
-        sourceBuffer += readBitVector(sourceBuffer, numJoints, [&](int i, bool value) {
-            _jointData[i].translationIsDefaultPose = value;
-        });
+        sourceBuffer += bitVectorSize;
+
+        if (_lazyJointDecoding) {
+            // the flags must be applied after the joints that came before them, so they wait with them
+            pendingJointData.defaultPoseFlags = QByteArray(reinterpret_cast<const char*>(startSection),
+                                                           sourceBuffer - startSection);
+        } else {
+            QWriteLocker writeLock(&_jointDataLock);
+            decodeJointDefaultPoseFlags(startSection);
+        }
 
         int numBytesRead = sourceBuffer - startSection;
         _jointDefaultPoseFlagsRate.increment(numBytesRead);
         _jointDefaultPoseFlagsUpdateRate.increment();
     }
 
+    if (!pendingJointData.joints.isEmpty() || !pendingJointData.defaultPoseFlags.isEmpty()) {
+        QWriteLocker writeLock(&_jointDataLock);
+        queuePendingJointData(pendingJointData);
+    }
+
     int numBytesRead = sourceBuffer - startPosition;
     _averageBytesReceived.updateAverage(numBytesRead);
 
@@ -1490,12 +1725,18 @@ void AvatarData::setRawJointData(QVector<JointData> data) {
     }
     QWriteLocker writeLock(&_jointDataLock);
     _jointData = data;
+    markJointDataChanged();
+
+    // anything still packed is older than the joints we were just given
+    _pendingJointData = PendingJointData();
+    _hasPendingJointData = false;
 }
 
 void AvatarData::setJointData(int index, const glm::quat& rotation, const glm::vec3& translation) {
     if (index < 0 || index >= LOWEST_PSEUDO_JOINT_INDEX) {
         return;
     }
+    decodePendingJointData();
     QWriteLocker writeLock(&_jointDataLock);
     if (_jointData.size() <= index) {
         _jointData.resize(index + 1);
@@ -1505,18 +1746,21 @@ void AvatarData::setJointData(int index, const glm::quat& rotation, const glm::v
     data.rotationIsDefaultPose = false;
     data.translation = translation;
     data.translationIsDefaultPose = false;
+    markJointDataChanged();
 }
 
 void AvatarData::clearJointData(int index) {
     if (index < 0 || index >= LOWEST_PSEUDO_JOINT_INDEX) {
         return;
     }
+    decodePendingJointData();
     QWriteLocker writeLock(&_jointDataLock);
     // FIXME: I don't understand how this "clears" the joint data at index
     if (_jointData.size() <= index) {
         _jointData.resize(index + 1);
     }
     _jointData[index] = {};
+    markJointDataChanged();
 }
 
 bool AvatarData::isJointDataValid(int index) const {
@@ -1540,6 +1784,7 @@ bool AvatarData::isJointDataValid(int index) const {
             if (index < 0 || index >= LOWEST_PSEUDO_JOINT_INDEX) {
                 return false;
             }
+            decodePendingJointData();
             QReadLocker readLock(&_jointDataLock);
             return index < _jointData.size();
         }
@@ -1561,6 +1806,7 @@ glm::quat AvatarData::getJointRotation(int index) const {
             if (index < 0 || index >= LOWEST_PSEUDO_JOINT_INDEX) {
                 return glm::quat();
             }
+            decodePendingJointData();
             QReadLocker readLock(&_jointDataLock);
             return index < _jointData.size() ? _jointData.at(index).rotation : glm::quat();
         }
@@ -1582,6 +1828,7 @@ glm::vec3 AvatarData::getJointTranslation(int index) const {
             if (index < 0 || index >= LOWEST_PSEUDO_JOINT_INDEX) {
                 return glm::vec3();
             }
+            decodePendingJointData();
             QReadLocker readLock(&_jointDataLock);
             return index < _jointData.size() ? _jointData.at(index).translation : glm::vec3();
         }
@@ -1635,6 +1882,7 @@ void AvatarData::setJointRotation(int index, const glm::quat& rotation) {
     if (index < 0 || index >= LOWEST_PSEUDO_JOINT_INDEX) {
         return;
     }
+    decodePendingJointData();
     QWriteLocker writeLock(&_jointDataLock);
     if (_jointData.size() <= index) {
         _jointData.resize(index + 1);
@@ -1642,12 +1890,14 @@ void AvatarData::setJointRotation(int index, const glm::quat& rotation) {
     JointData& data = _jointData[index];
     data.rotation = rotation;
     data.rotationIsDefaultPose = false;
+    markJointDataChanged();
 }
 
 void AvatarData::setJointTranslation(int index, const glm::vec3& translation) {
     if (index < 0 || index >= LOWEST_PSEUDO_JOINT_INDEX) {
         return;
     }
+    decodePendingJointData();
     QWriteLocker writeLock(&_jointDataLock);
     if (_jointData.size() <= index) {
         _jointData.resize(index + 1);
@@ -1655,6 +1905,7 @@ void AvatarData::setJointTranslation(int index, const glm::vec3& translation) {
     JointData& data = _jointData[index];
     data.translation = translation;
     data.translationIsDefaultPose = false;
+    markJointDataChanged();
 }
 
 void AvatarData::clearJointData(const QString& name) {
@@ -1693,6 +1944,7 @@ QVector<glm::quat> AvatarData::getJointRotations() const {
                                   Q_RETURN_ARG(QVector<glm::quat>, result));
         return result;
     }
+    decodePendingJointData();
     QReadLocker readLock(&_jointDataLock);
     QVector<glm::quat> jointRotations(_jointData.size());
     for (int i = 0; i < _jointData.size(); ++i) {
@@ -1702,6 +1954,7 @@ QVector<glm::quat> AvatarData::getJointRotations() const {
 }
 
 void AvatarData::setJointRotations(const QVector<glm::quat>& jointRotations) {
+    decodePendingJointData();
     QWriteLocker writeLock(&_jointDataLock);
     auto size = jointRotations.size();
     if (_jointData.size() < size) {
@@ -1712,9 +1965,11 @@ void AvatarData::setJointRotations(const QVector<glm::quat>& jointRotations) {
         data.rotation = jointRotations[i];
         data.rotationIsDefaultPose = false;
     }
+    markJointDataChanged();
 }
 
 QVector<glm::vec3> AvatarData::getJointTranslations() const {
+    decodePendingJointData();
     QReadLocker readLock(&_jointDataLock);
     QVector<glm::vec3> jointTranslations(_jointData.size());
     for (int i = 0; i < _jointData.size(); ++i) {
@@ -1724,6 +1979,7 @@ QVector<glm::vec3> AvatarData::getJointTranslations() const {
 }
 
 void AvatarData::setJointTranslations(const QVector<glm::vec3>& jointTranslations) {
+    decodePendingJointData();
     QWriteLocker writeLock(&_jointDataLock);
     auto size = jointTranslations.size();
     if (_jointData.size() < size) {
@@ -1734,13 +1990,16 @@ void AvatarData::setJointTranslations(const QVector<glm::vec3>& jointTranslation
         data.translation = jointTranslations[i];
         data.translationIsDefaultPose = false;
     }
+    markJointDataChanged();
 }
 
 void AvatarData::clearJointsData() {
+    decodePendingJointData();
     QWriteLocker writeLock(&_jointDataLock);
     QVector<JointData> newJointData;
     newJointData.resize(_jointData.size());
     _jointData.swap(newJointData);
+    markJointDataChanged();
 }
 
 int AvatarData::getFauxJointIndex(const QString& name) const {
@@ -2216,6 +2475,7 @@ void AvatarData::updateJointMappings() {
         _fstJointIndices.clear();
         _fstJointNames.clear();
         _jointData.clear();
+        markJointDataChanged();
     }
 
     if (_skeletonModelURL.fileName().toLower().endsWith(".fst")) {
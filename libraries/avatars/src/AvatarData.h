@@ -15,6 +15,8 @@
 #include <string>
 #include <memory>
 #include <queue>
+#include <atomic>
+#include <mutex>
 #include <inttypes.h>
 #include <vector>
 
@@ -613,7 +615,7 @@ public:
      */
     Q_INVOKABLE char getHandState() const { return _handState; }
 
-    const QVector<JointData>& getRawJointData() const { return _jointData; }
+    const QVector<JointData>& getRawJointData() const { decodePendingJointData(); return _jointData; }
 
     /**jsdoc
      * @function MyAvatar.setRawJointData
@@ -1184,9 +1186,15 @@ public:
      */
     Q_INVOKABLE float getUpdateRate(const QString& rateName = QString("")) const;
 
-    int getJointCount() const { return _jointData.size(); }
+    int getJointCount() const { decodePendingJointData(); return _jointData.size(); }
+
+    // Returns a structure-of-arrays copy of the current joints, shared with every other caller
+    // until the joints change again. Callers can read it without holding _jointDataLock. It pays off where many
+    // readers share one version, like the mixer encoding an avatar for every listener, so rendering reads _jointData.
+    JointDataSnapshotPointer getJointDataSnapshot() const;
 
     QVector<JointData> getLastSentJointData() {
+        decodePendingJointData();
         QReadLocker readLock(&_jointDataLock);
         _lastSentJointData.resize(_jointData.size());
         return _lastSentJointData;
@@ -1205,6 +1213,7 @@ public:
     void markIdentityDataChanged() { _identityDataChanged = true; }
 
     void pushIdentitySequenceNumber() { ++_identitySequenceNumber; };
+    udt::SequenceNumber getIdentitySequenceNumber() const { return _identitySequenceNumber; }
     bool hasProcessedFirstIdentity() const { return _hasProcessedFirstIdentity; }
 
     float getDensity() const { return _density; }
@@ -1219,6 +1228,11 @@ public:
     static const float DEFAULT_BUBBLE_SCALE;  /* = 2.4 */
     AABox computeBubbleBox(float bubbleScale = DEFAULT_BUBBLE_SCALE) const;
 
+    // When enabled, parseDataFromBuffer keeps the packed joint sections and only decodes them when the joints are read.
+    // Used by the avatar mixer, where joints are only needed for avatars that some listener is sent full data about.
+    // Subclasses that touch _jointData directly must not enable this.
+    void setLazyJointDecoding(bool lazyJointDecoding);
+
     void setIsNewAvatar(bool isNewAvatar) { _isNewAvatar = isNewAvatar; }
     bool getIsNewAvatar() { return _isNewAvatar; }
     void setIsClientAvatar(bool isClientAvatar) { _isClientAvatar = isClientAvatar; }
@@ -1363,15 +1377,37 @@ protected:
     //  Hand state (are we grabbing something or not)
     char _handState;
 
-    QVector<JointData> _jointData; ///< the state of the skeleton joints
+    // mutable so that packed joint sections can be decoded on demand from const readers
+    mutable QVector<JointData> _jointData; ///< the state of the skeleton joints
     QVector<JointData> _lastSentJointData; ///< the state of the skeleton joints last time we transmitted
     mutable QReadWriteLock _jointDataLock;
 
+    // packed joint sections received but not yet decoded, later packets are merged into them, guarded by _jointDataLock
+    struct PendingJointData {
+        QByteArray joints;
+        QByteArray defaultPoseFlags;
+    };
+    mutable PendingJointData _pendingJointData;
+    mutable std::atomic<bool> _hasPendingJointData { false };
+    bool _lazyJointDecoding { false };
+
+    void queuePendingJointData(PendingJointData& pendingJointData);
+    void applyPendingJointData() const;
+    void decodePendingJointData() const;
+    int decodeJointSection(const unsigned char* sourceBuffer) const;
+    int decodeJointDefaultPoseFlags(const unsigned char* sourceBuffer) const;
+
+    // must be called by anything that writes _jointData so that the next snapshot is rebuilt
+    void markJointDataChanged() const { ++_jointDataVersion; }
+    mutable std::atomic<uint32_t> _jointDataVersion { 1 };
+    mutable std::shared_ptr<JointDataSnapshot> _jointDataSnapshot;
+    mutable std::mutex _jointDataSnapshotMutex;
+
     // key state
     KeyState _keyState;
 
     bool _forceFaceTrackerConnected;
-    bool _hasNewJointData { true }; // set in AvatarData, cleared in Avatar
+    mutable bool _hasNewJointData { true }; // set in AvatarData, cleared in Avatar
 
     mutable HeadData* _headData { nullptr };
 
@@ -1495,6 +1531,7 @@ protected:
     template <typename T, typename F>
     T readLockWithNamedJointIndex(const QString& name, const T& defaultValue, F f) const {
         int index = getFauxJointIndex(name);
+        decodePendingJointData();
         QReadLocker readLock(&_jointDataLock);
         if (index == -1) {
             index = _fstJointIndices.value(name) - 1;
@@ -1516,6 +1553,7 @@ protected:
     template <typename F>
     void writeLockWithNamedJointIndex(const QString& name, F f) {
         int index = getFauxJointIndex(name);
+        decodePendingJointData();
         QWriteLocker writeLock(&_jointDataLock);
         if (index == -1) {
             index = _fstJointIndices.value(name) - 1;
@@ -1527,6 +1565,7 @@ protected:
             _jointData.resize(index + 1);
         }
         f(index);
+        markJointDataChanged();
     }
 
 private:
@@ -1392,6 +1392,8 @@ void ModelEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& sce
         withWriteLock([&] {
             _prevModelLoaded = false;
         });
+        // we're called every frame until the model loads, so its priority follows the avatar around
+        model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
         emit requestRenderUpdate();
         return;
     } else if (!_prevModelLoaded) {
@@ -1475,6 +1477,7 @@ void ModelEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& sce
         });
         model->updateRenderItems();
     } else if (!_texturesLoaded) {
+        model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
         emit requestRenderUpdate();
     }
 
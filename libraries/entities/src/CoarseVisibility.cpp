@@ -0,0 +1,177 @@
+//
+//  CoarseVisibility.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CoarseVisibility.h"
+
+#include <functional>
+
+#include <NumericalConstants.h>
+#include <OctreeUtils.h>
+#include <SharedUtil.h>
+
+#include "EntityTree.h"
+
+namespace {
+
+class CoarseVisibilityBuildTask : public QRunnable {
+public:
+    CoarseVisibilityBuildTask(std::function<void()> build) : _build(build) {}
+
+    void run() override { _build(); }
+
+private:
+    std::function<void()> _build;
+};
+
+}
+
+const float CoarseVisibilityCache::DEFAULT_CELL_SIZE = 16.0f;
+const uint64_t CoarseVisibilityCache::DEFAULT_MAX_AGE = 100 * USECS_PER_MSEC;
+
+// the same test as DiffTraversal::View::shouldTraverseElement, from the nearest point of the cell and without the frustum
+bool CoarseVisibility::isLargeEnough(const EntityTreeElement& element) const {
+    const auto& cube = element.getAACube();
+    auto center = cube.calcCenter();
+    auto radius = 0.5f * SQRT_THREE * cube.getScale(); // radius of bounding sphere
+
+    glm::vec3 nearest = glm::clamp(center, _cell.getMinimumPoint(), _cell.getMaximumPoint());
+    float distance = glm::length(center - nearest);
+
+    const float AVOID_DIVIDE_BY_ZERO = 0.001f; // as in ConicalViewFrustum::getAngularSize
+    float angularSize = radius / (distance + AVOID_DIVIDE_BY_ZERO);
+    return angularSize > _lodScaleFactor * MIN_ELEMENT_ANGULAR_DIAMETER;
+}
+
+void CoarseVisibility::addSubtree(const EntityTreeElementPointer& element) {
+    size_t index = _entries.size();
+    _entries.push_back({ element, 0 });
+
+    element->forEachChild([&](int childIndex, const OctreeElementPointer& child) {
+        auto entityChild = std::static_pointer_cast<EntityTreeElement>(child);
+        if (isLargeEnough(*entityChild)) {
+            addSubtree(entityChild);
+        }
+    });
+
+    _entries[index].subtreeEnd = (uint32_t)_entries.size();
+}
+
+CoarseVisibility::CoarseVisibility(const EntityTreeElementPointer& root, const AABox& cell, float lodScaleFactor) :
+    _cell(cell),
+    _lodScaleFactor(lodScaleFactor),
+    _buildTime(usecTimestampNow())
+{
+    // like DiffTraversal, the root is always visited
+    auto tree = root->getTree();
+    if (tree) {
+        tree->withReadLock([&] {
+            addSubtree(root);
+        });
+    } else {
+        addSubtree(root);
+    }
+}
+
+CoarseVisibilityCache::CoarseVisibilityCache(float cellSize, uint64_t maxAge) :
+    _cellSize(cellSize),
+    _maxAge(maxAge)
+{
+    // one build at a time is plenty at one pass per shared cell per frame, and leaves the cores to the send threads
+    _buildPool.setMaxThreadCount(1);
+}
+
+size_t CoarseVisibilityCache::KeyHash::operator()(const Key& key) const {
+    size_t hash = std::hash<int>()(key.cell.x);
+    hash = hash * 31 + std::hash<int>()(key.cell.y);
+    hash = hash * 31 + std::hash<int>()(key.cell.z);
+    return hash * 31 + std::hash<float>()(key.lodScaleFactor);
+}
+
+CoarseVisibilityPointer CoarseVisibilityCache::get(const DiffTraversal::View& view, const EntityTreeElementPointer& root,
+                                                   const void* requester) {
+    if (!root || !view.usesViewFrustums()) {
+        return CoarseVisibilityPointer();
+    }
+
+    Key key;
+    key.cell = glm::ivec3(glm::floor(view.viewFrustums[0].getPosition() / _cellSize));
+    key.lodScaleFactor = view.lodScaleFactor;
+    for (const auto& frustum : view.viewFrustums) {
+        if (glm::ivec3(glm::floor(frustum.getPosition() / _cellSize)) != key.cell) {
+            return CoarseVisibilityPointer();
+        }
+    }
+
+    uint64_t now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_lastSweep + _maxAge <= now) {
+        removeStaleCells(now);
+    }
+
+    auto& cell = _cells[key];
+    cell.requests[requester] = now;
+
+    if (cell.visibility && cell.visibility->getEntries().front().element == root &&
+        cell.visibility->getBuildTime() + _maxAge > now) {
+        ++_numHits;
+        return cell.visibility;
+    }
+
+    // only build for a cell that is shared
+    removeStaleRequests(cell, now);
+    if (cell.requests.size() > 1 && !cell.isBuilding) {
+        cell.isBuilding = true;
+        _buildPool.start(new CoarseVisibilityBuildTask([this, key, root] {
+            build(key, root);
+        }));
+    }
+    return CoarseVisibilityPointer();
+}
+
+void CoarseVisibilityCache::build(const Key& key, const EntityTreeElementPointer& root) {
+    // takes the read lock of the tree on this thread, instead of inside the send loop of a view
+    AABox cellBox(glm::vec3(key.cell) * _cellSize, _cellSize);
+    auto visibility = std::make_shared<const CoarseVisibility>(root, cellBox, key.lodScaleFactor);
+    uint64_t now = usecTimestampNow();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_numBuilds;
+    auto& cell = _cells[key];
+    cell.visibility = visibility;
+    cell.isBuilding = false;
+}
+
+void CoarseVisibilityCache::removeStaleRequests(Cell& cell, uint64_t now) const {
+    for (auto it = cell.requests.begin(); it != cell.requests.end();) {
+        if (it->second + _maxAge <= now) {
+            it = cell.requests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void CoarseVisibilityCache::removeStaleCells(uint64_t now) {
+    _lastSweep = now;
+    for (auto it = _cells.begin(); it != _cells.end();) {
+        auto& cell = it->second;
+        removeStaleRequests(cell, now);
+        if (cell.visibility && cell.visibility->getBuildTime() + _maxAge <= now) {
+            cell.visibility.reset();
+        }
+
+        if (!cell.visibility && !cell.isBuilding && cell.requests.empty()) {
+            it = _cells.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,112 @@
+//
+//  CoarseVisibility.h
+//  libraries/entities/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CoarseVisibility_h
+#define hifi_CoarseVisibility_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <QtCore/QThreadPool>
+
+#include <AABox.h>
+
+#include "DiffTraversal.h"
+
+// The elements of a tree that are large enough to be seen from somewhere in a cell of viewpoints, looking any way.
+//   The elements are listed in the order DiffTraversal visits them, each with the end of its subtree, so a traversal
+//   for a view in the cell can walk the list instead of the tree, and skip a subtree when its own frustum test fails.
+class CoarseVisibility {
+public:
+    struct Entry {
+        EntityTreeElementPointer element;
+        uint32_t subtreeEnd; // index of the first entry after the subtree of this element
+    };
+
+    CoarseVisibility(const EntityTreeElementPointer& root, const AABox& cell, float lodScaleFactor);
+
+    const std::vector<Entry>& getEntries() const { return _entries; }
+    const AABox& getCell() const { return _cell; }
+    float getLODScaleFactor() const { return _lodScaleFactor; }
+    uint64_t getBuildTime() const { return _buildTime; }
+
+private:
+    bool isLargeEnough(const EntityTreeElement& element) const;
+    void addSubtree(const EntityTreeElementPointer& element);
+
+    AABox _cell;
+    float _lodScaleFactor;
+    uint64_t _buildTime;
+    std::vector<Entry> _entries;
+};
+
+using CoarseVisibilityPointer = std::shared_ptr<const CoarseVisibility>;
+
+// Coarse visibility for the cells that views are in, shared by the traversals of every view in the same cell
+//   and rebuilt once it is older than a frame. A cell only gets a pass once more than one traversal asks for it
+//   within a frame, since a pass for a single view costs more than it saves. The passes are built on a thread of
+//   the cache, and traversals walk the tree until theirs is ready. The send threads of an entity server share one cache.
+class CoarseVisibilityCache {
+public:
+    static const float DEFAULT_CELL_SIZE; // meters
+    static const uint64_t DEFAULT_MAX_AGE; // usecs
+
+    CoarseVisibilityCache(float cellSize = DEFAULT_CELL_SIZE, uint64_t maxAge = DEFAULT_MAX_AGE);
+
+    // returns nullptr for views that can't use a shared pass: without frustums, or with frustums in several cells,
+    // and while the pass for their cell isn't shared or isn't built yet. The requester tells the traversals apart.
+    CoarseVisibilityPointer get(const DiffTraversal::View& view, const EntityTreeElementPointer& root,
+                                const void* requester);
+
+    void waitForBuilds() { _buildPool.waitForDone(); }
+
+    size_t getNumBuilds() const { return _numBuilds; }
+    size_t getNumHits() const { return _numHits; }
+
+private:
+    struct Key {
+        glm::ivec3 cell;
+        float lodScaleFactor;
+        bool operator==(const Key& other) const { return cell == other.cell && lodScaleFactor == other.lodScaleFactor; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Cell {
+        CoarseVisibilityPointer visibility;
+        std::unordered_map<const void*, uint64_t> requests; // last request of each traversal
+        bool isBuilding { false };
+    };
+
+    void build(const Key& key, const EntityTreeElementPointer& root);
+    void removeStaleRequests(Cell& cell, uint64_t now) const;
+    void removeStaleCells(uint64_t now); // requires _mutex
+
+    const float _cellSize;
+    const uint64_t _maxAge;
+
+    std::mutex _mutex;
+    std::unordered_map<Key, Cell, KeyHash> _cells; // guarded by _mutex
+    uint64_t _lastSweep { 0 }; // guarded by _mutex
+    std::atomic<size_t> _numBuilds { 0 };
+    std::atomic<size_t> _numHits { 0 };
+
+    QThreadPool _buildPool; // last, so pending builds finish before the cells go away
+};
+
+#endif // hifi_CoarseVisibility_h
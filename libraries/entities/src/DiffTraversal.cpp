@@ -13,6 +13,7 @@
 
 #include <OctreeUtils.h>
 
+#include "CoarseVisibility.h"
 #include "EntityPriorityQueue.h"
 
 DiffTraversal::Waypoint::Waypoint(EntityTreeElementPointer& element) : _nextIndex(0) {
@@ -35,6 +36,10 @@ void DiffTraversal::Waypoint::getNextVisibleElementFirstTime(DiffTraversal::Visi
         EntityTreeElementPointer element = _weakElement.lock();
         if (element) {
             while (_nextIndex < NUMBER_OF_CHILDREN) {
+                if (!element->hasChildAtIndex(_nextIndex)) {
+                    ++_nextIndex;
+                    continue;
+                }
                 EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
                 ++_nextIndex;
                 if (nextElement && view.shouldTraverseElement(*nextElement)) {
@@ -62,6 +67,10 @@ void DiffTraversal::Waypoint::getNextVisibleElementRepeat(
         EntityTreeElementPointer element = _weakElement.lock();
         if (element) {
             while (_nextIndex < NUMBER_OF_CHILDREN) {
+                if (!element->hasChildAtIndex(_nextIndex)) {
+                    ++_nextIndex;
+                    continue;
+                }
                 EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
                 ++_nextIndex;
                 if (nextElement &&
@@ -89,6 +98,10 @@ void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::V
         EntityTreeElementPointer element = _weakElement.lock();
         if (element) {
             while (_nextIndex < NUMBER_OF_CHILDREN) {
+                if (!element->hasChildAtIndex(_nextIndex)) {
+                    ++_nextIndex;
+                    continue;
+                }
                 EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
                 ++_nextIndex;
                 if (nextElement && view.shouldTraverseElement(*nextElement)) {
@@ -193,7 +206,8 @@ DiffTraversal::DiffTraversal() {
     _path.reserve(MIN_PATH_DEPTH);
 }
 
-DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root) {
+DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
+                                                       CoarseVisibilityCache* coarseVisibilityCache) {
     assert(root);
     // there are three types of traversal:
     //
@@ -234,16 +248,52 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     }
 
     _path.clear();
-    _path.push_back(DiffTraversal::Waypoint(root));
-    // set root fork's index such that root element returned at getNextElement()
-    _path.back().initRootNextIndex();
-
+    _coarseVisibility.reset();
     _currentView.startTime = usecTimestampNow();
 
+    // a Repeat only descends into changed elements, which is already cheaper than walking the coarse visibility
+    if (coarseVisibilityCache && type != Type::Repeat) {
+        _coarseVisibility = coarseVisibilityCache->get(_currentView, root, this);
+    }
+
+    if (_coarseVisibility) {
+        _coarseIndex = 0;
+        // anything that changed after the coarse pass was built may be missing from it, the next Repeat picks it up
+        _currentView.startTime = std::min(_currentView.startTime, _coarseVisibility->getBuildTime());
+    } else {
+        _path.push_back(DiffTraversal::Waypoint(root));
+        // set root fork's index such that root element returned at getNextElement()
+        _path.back().initRootNextIndex();
+    }
+
     return type;
 }
 
+void DiffTraversal::getNextCoarselyVisibleElement(DiffTraversal::VisibleElement& next) {
+    const auto& entries = _coarseVisibility->getEntries();
+    while (_coarseIndex < entries.size()) {
+        const auto& entry = entries[_coarseIndex];
+
+        // the root is always visited, and a subtree is skipped when its root fails the frustum tests of the view
+        if (_coarseIndex == 0 || _currentView.shouldTraverseElement(*entry.element)) {
+            ++_coarseIndex;
+            next.element = entry.element;
+            return;
+        }
+        _coarseIndex = entry.subtreeEnd;
+    }
+
+    // we've walked the entire coarse visibility
+    _coarseVisibility.reset();
+    _completedView = _currentView;
+    next.element.reset();
+}
+
 void DiffTraversal::getNextVisibleElement(DiffTraversal::VisibleElement& next) {
+    if (_coarseVisibility) {
+        getNextCoarselyVisibleElement(next);
+        return;
+    }
     if (_path.empty()) {
         next.element.reset();
         return;
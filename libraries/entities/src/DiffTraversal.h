@@ -16,6 +16,9 @@
 
 #include "EntityTreeElement.h"
 
+class CoarseVisibility;
+class CoarseVisibilityCache;
+
 // DiffTraversal traverses the tree and applies _scanElementCallback on elements it finds
 class DiffTraversal {
 public:
@@ -61,24 +64,31 @@ public:
 
     DiffTraversal();
 
-    Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root);
+    // First and Differential traversals of a view with a coarseVisibilityCache walk the coarse visibility its cell shares
+    // with other views, once the cache has one, instead of the tree, and only run the frustum tests of the view
+    Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
+                             CoarseVisibilityCache* coarseVisibilityCache = nullptr);
 
     const View& getCurrentView() const { return _currentView; }
 
     uint64_t getStartOfCompletedTraversal() const { return _completedView.startTime; }
-    bool finished() const { return _path.empty(); }
+    bool finished() const { return _path.empty() && !_coarseVisibility; }
 
     void setScanCallback(std::function<void (VisibleElement&)> cb);
     void traverse(uint64_t timeBudget);
 
-    void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
+    // resets our state to force a new "First" traversal
+    void reset() { _path.clear(); _coarseVisibility.reset(); _completedView.startTime = 0; }
 
 private:
     void getNextVisibleElement(VisibleElement& next);
+    void getNextCoarselyVisibleElement(VisibleElement& next);
 
     View _currentView;
     View _completedView;
     std::vector<Waypoint> _path;
+    std::shared_ptr<const CoarseVisibility> _coarseVisibility;
+    uint32_t _coarseIndex { 0 };
     std::function<void (VisibleElement&)> _getNextVisibleElementCallback { nullptr };
     std::function<void (VisibleElement&)> _scanElementCallback { [](VisibleElement& e){} };
 };
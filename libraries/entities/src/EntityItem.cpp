@@ -363,6 +363,82 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     return appendState;
 }
 
+std::atomic<quint64> EntityItem::_encodedDataCacheHits { 0 };
+std::atomic<quint64> EntityItem::_encodedDataCacheMisses { 0 };
+
+EntityItem::EncodedDataVersion EntityItem::getEncodedDataVersion() const {
+    EncodedDataVersion version;
+    withReadLock([&] {
+        version.changedOnServer = _changedOnServer;
+        version.lastEdited = _lastEdited;
+        version.lastUpdated = _lastUpdated;
+        version.lastSimulated = _lastSimulated;
+    });
+    return version;
+}
+
+QByteArray EntityItem::getEncodedData(EncodedDataVersion& version) const {
+    version = getEncodedDataVersion();
+
+    std::lock_guard<std::mutex> lock(_encodedDataMutex);
+    if (_hasEncodedData && _encodedDataVersion == version) {
+        ++_encodedDataCacheHits;
+        return _encodedData;
+    }
+    ++_encodedDataCacheMisses;
+
+    // encode everything into a packet of our own, with default params so this encode isn't tracked as a send
+    OctreePacketData packetData;
+    EncodeBitstreamParams params;
+    EntityTreeElementExtraEncodeDataPointer extraEncodeData { new EntityTreeElementExtraEncodeData() };
+    if (appendEntityData(&packetData, params, extraEncodeData) == OctreeElement::COMPLETED) {
+        _encodedData = QByteArray((const char*)packetData.getUncompressedData(), packetData.getUncompressedSize());
+    } else {
+        _encodedData.clear();
+    }
+
+    // an edit during the encode leaves us keyed to the older version, so the next call encodes again
+    _encodedDataVersion = version;
+    _hasEncodedData = true;
+    return _encodedData;
+}
+
+OctreeElement::AppendState EntityItem::appendCachedEntityData(OctreePacketData* packetData, EncodeBitstreamParams& params,
+                                            EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData) const {
+    bool resumingPartialSend = entityTreeElementExtraEncodeData &&
+        entityTreeElementExtraEncodeData->entities.contains(getEntityItemID());
+
+    if (!resumingPartialSend) {
+        EncodedDataVersion version;
+        QByteArray encodedData = getEncodedData(version);
+        if (!encodedData.isEmpty() && encodedData.size() <= packetData->getBytesAvailable() &&
+                packetData->appendRawData(encodedData)) {
+            params.trackSend(getID(), version.lastEdited);
+            return OctreeElement::COMPLETED;
+        }
+    }
+
+    return appendEntityData(packetData, params, entityTreeElementExtraEncodeData);
+}
+
+QByteArray EntityItem::getPersistData() const {
+    EncodedDataVersion version;
+    QByteArray encodedData = getEncodedData(version);
+    if (!encodedData.isEmpty()) {
+        return encodedData;
+    }
+
+    // the encoding didn't fit in a packet, which doesn't matter on disk
+    const int MAX_PERSIST_DATA_SIZE = 4 * 1024 * 1024;
+    OctreePacketData packetData(false, MAX_PERSIST_DATA_SIZE);
+    EncodeBitstreamParams params;
+    EntityTreeElementExtraEncodeDataPointer extraEncodeData { new EntityTreeElementExtraEncodeData() };
+    if (appendEntityData(&packetData, params, extraEncodeData) == OctreeElement::COMPLETED) {
+        encodedData = QByteArray((const char*)packetData.getUncompressedData(), packetData.getUncompressedSize());
+    }
+    return encodedData;
+}
+
 // TODO: My goal is to get rid of this concept completely. The old code (and some of the current code) used this
 // result to calculate if a packet being sent to it was potentially bad or corrupt. I've adjusted this to now
 // only consider the minimum header bytes as being required. But it would be preferable to completely eliminate
@@ -12,7 +12,9 @@
 #ifndef hifi_EntityItem_h
 #define hifi_EntityItem_h
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 
 #include <glm/glm.hpp>
@@ -126,6 +128,19 @@ public:
     virtual OctreeElement::AppendState appendEntityData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                                         EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData) const;
 
+    /// Appends this entity from a cached copy of its full encoding, shared by every client it is sent to and re-encoded
+    /// only after the entity changes. Falls back to appendEntityData when resuming a partial send of this entity or
+    /// when the full encoding doesn't fit in what is left of the packet.
+    OctreeElement::AppendState appendCachedEntityData(OctreePacketData* packetData, EncodeBitstreamParams& params,
+                                                      EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData) const;
+
+    /// The full bitstream encoding of this entity, as appendCachedEntityData would send it, for the persist journal.
+    /// Unlike a send it isn't limited to the size of a packet. Returns an empty array if the entity could not be encoded.
+    QByteArray getPersistData() const;
+
+    static quint64 getEncodedDataCacheHits() { return _encodedDataCacheHits; }
+    static quint64 getEncodedDataCacheMisses() { return _encodedDataCacheMisses; }
+
     virtual void appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                     EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                     EntityPropertyFlags& requestedProperties,
@@ -568,6 +583,27 @@ protected:
     quint64 _created { 0 };
     quint64 _changedOnServer { 0 };
 
+    // full encoding of this entity and the change times it was encoded at, see appendCachedEntityData
+    struct EncodedDataVersion {
+        quint64 changedOnServer { 0 };
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+
+        bool operator==(const EncodedDataVersion& other) const {
+            return changedOnServer == other.changedOnServer && lastEdited == other.lastEdited &&
+                lastUpdated == other.lastUpdated && lastSimulated == other.lastSimulated;
+        }
+    };
+    EncodedDataVersion getEncodedDataVersion() const;
+    QByteArray getEncodedData(EncodedDataVersion& version) const;
+    mutable std::mutex _encodedDataMutex;
+    mutable QByteArray _encodedData; // guarded by _encodedDataMutex, empty if the full encoding didn't fit a packet
+    mutable EncodedDataVersion _encodedDataVersion; // guarded by _encodedDataMutex
+    mutable bool _hasEncodedData { false }; // guarded by _encodedDataMutex
+    static std::atomic<quint64> _encodedDataCacheHits;
+    static std::atomic<quint64> _encodedDataCacheMisses;
+
     mutable AABox _cachedAABox;
     mutable AACube _maxAACube;
     mutable AACube _minAACube;
@@ -2651,6 +2651,43 @@ QByteArray EntityItemProperties::packStrokeColors(const QVector<vec3>& strokeCol
 //
 // TODO: Implement support for script and visible properties.
 //
+bool EntityItemProperties::decodeEntityEditPacketHeader(const unsigned char* data, int bytesToRead,
+                                                        EntityItemID& entityID, EntityPropertyFlags& propertyFlags) {
+    // this follows the layout read by decodeEntityEditPacket, but stops once it has the property flags
+    int processedBytes = (int)bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(data));
+    processedBytes += sizeof(quint64); // last edited
+    if (bytesToRead - processedBytes < NUM_BYTES_RFC4122_UUID) {
+        return false;
+    }
+
+    const unsigned char* dataAt = data + processedBytes;
+    entityID = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(dataAt), NUM_BYTES_RFC4122_UUID));
+    dataAt += NUM_BYTES_RFC4122_UUID;
+    processedBytes += NUM_BYTES_RFC4122_UUID;
+
+    // entity type
+    QByteArray encodedType((const char*)dataAt, (bytesToRead - processedBytes));
+    ByteCountCoded<quint32> typeCoder = encodedType;
+    encodedType = typeCoder;
+    dataAt += encodedType.size();
+    processedBytes += encodedType.size();
+
+    // update delta
+    QByteArray encodedUpdateDelta((const char*)dataAt, (bytesToRead - processedBytes));
+    ByteCountCoded<quint64> updateDeltaCoder = encodedUpdateDelta;
+    encodedUpdateDelta = updateDeltaCoder;
+    dataAt += encodedUpdateDelta.size();
+    processedBytes += encodedUpdateDelta.size();
+
+    if (processedBytes >= bytesToRead) {
+        return false;
+    }
+
+    QByteArray encodedPropertyFlags((const char*)dataAt, (bytesToRead - processedBytes));
+    propertyFlags = encodedPropertyFlags;
+    return true;
+}
+
 bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
                                                   EntityItemID& entityID, EntityItemProperties& properties) {
     bool valid = false;
@@ -325,6 +325,9 @@ public:
 
     static bool decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
                                        EntityItemID& entityID, EntityItemProperties& properties);
+    // reads only the entity ID and the flags of the properties an edit packet carries
+    static bool decodeEntityEditPacketHeader(const unsigned char* data, int bytesToRead,
+                                             EntityItemID& entityID, EntityPropertyFlags& propertyFlags);
 
     bool localRenderAlphaChanged() const { return _localRenderAlphaChanged; }
 
@@ -0,0 +1,388 @@
+//
+//  EntityPersistJournal.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPersistJournal.h"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include <QFile>
+#include <QSaveFile>
+#include <QSet>
+
+#include <SharedUtil.h>
+#include <TBBHelpers.h>
+#include <UUID.h>
+#include <udt/PacketHeaders.h>
+
+#include "AddEntityOperator.h"
+#include "EntitiesLogging.h"
+#include "EntityTree.h"
+#include "EntityTypes.h"
+
+// Like the entity bitstream itself, everything in the journal is stored in host byte order.
+//
+// header:  magic [4 bytes] | format version [uint32] | entity data packet version [uint32]
+//          | persist ID [16 bytes] | data version [int64], both of the last commit
+// record:  type [uint8] | payload length [uint32] | payload
+//
+//   ENTITY_RECORD payload:  the full bitstream encoding of the entity, which starts with its ID
+//   DELETE_RECORD payload:  the entity ID [16 bytes]
+//   COMMIT_RECORD payload:  persist ID [16 bytes] | data version [int64]
+
+const char JOURNAL_MAGIC[] = { 'H', 'F', 'E', 'J' };
+const uint32_t JOURNAL_FORMAT_VERSION = 2;
+const qint64 JOURNAL_VERSIONS_SIZE = sizeof(JOURNAL_MAGIC) + sizeof(uint32_t) + sizeof(uint32_t);
+const qint64 COMMIT_INFO_SIZE = NUM_BYTES_RFC4122_UUID + sizeof(int64_t);
+const qint64 JOURNAL_HEADER_SIZE = JOURNAL_VERSIONS_SIZE + COMMIT_INFO_SIZE;
+const qint64 RECORD_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint32_t);
+
+const uint8_t ENTITY_RECORD = 1;
+const uint8_t DELETE_RECORD = 2;
+const uint8_t COMMIT_RECORD = 3;
+
+// the journal is rewritten once it is this many times the size of its live records, or after this many appends
+const float MAX_JOURNAL_OVERHEAD = 2.0f;
+const qint64 MIN_COMPACTION_FILE_SIZE = 1024 * 1024;
+const int MAX_APPENDS_BETWEEN_COMPACTIONS = 1000;
+
+const size_t DECODES_PER_TASK = 256;
+
+static QByteArray journalVersions() {
+    QByteArray versions(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    uint32_t formatVersion = JOURNAL_FORMAT_VERSION;
+    uint32_t packetVersion = versionForPacketType(PacketType::EntityData);
+    versions.append((const char*)&formatVersion, sizeof(formatVersion));
+    versions.append((const char*)&packetVersion, sizeof(packetVersion));
+    return versions;
+}
+
+static QByteArray commitInfo(const QUuid& persistID, int64_t dataVersion) {
+    QByteArray info = persistID.toRfc4122();
+    info.append((const char*)&dataVersion, sizeof(dataVersion));
+    return info;
+}
+
+static void readCommitInfo(const uchar* data, QUuid& persistID, int64_t& dataVersion) {
+    persistID = QUuid::fromRfc4122(QByteArray::fromRawData((const char*)data, NUM_BYTES_RFC4122_UUID));
+    memcpy(&dataVersion, data + NUM_BYTES_RFC4122_UUID, sizeof(dataVersion));
+}
+
+static void appendRecord(QByteArray& buffer, uint8_t type, const QByteArray& payload) {
+    uint32_t length = payload.size();
+    buffer.append((const char*)&type, sizeof(type));
+    buffer.append((const char*)&length, sizeof(length));
+    buffer.append(payload);
+}
+
+static void appendCommitRecord(QByteArray& buffer, const QUuid& persistID, int64_t dataVersion) {
+    appendRecord(buffer, COMMIT_RECORD, commitInfo(persistID, dataVersion));
+}
+
+// Reads the record at offset, returns false if there isn't a complete record there
+static bool readRecord(const uchar* data, qint64 size, qint64 offset, uint8_t& type, qint64& payloadLength) {
+    if (offset + RECORD_HEADER_SIZE > size) {
+        return false;
+    }
+
+    uint32_t length;
+    memcpy(&type, data + offset, sizeof(type));
+    memcpy(&length, data + offset + sizeof(type), sizeof(length));
+    payloadLength = length;
+    return offset + RECORD_HEADER_SIZE + payloadLength <= size;
+}
+
+bool EntityPersistJournal::readInfo(const QString& filename, QUuid& persistID, int64_t& dataVersion) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QByteArray header = file.read(JOURNAL_HEADER_SIZE);
+    if (header.size() != JOURNAL_HEADER_SIZE || !header.startsWith(journalVersions())) {
+        return false;
+    }
+
+    readCommitInfo((const uchar*)header.constData() + JOURNAL_VERSIONS_SIZE, persistID, dataVersion);
+    return true;
+}
+
+bool EntityPersistJournal::load(EntityTree& tree, QUuid& persistID, int64_t& dataVersion) {
+    _needsRewrite = true;
+    _records.clear();
+    _fileSize = 0;
+    _liveBytes = 0;
+
+    QFile file(_filename);
+    if (!file.exists()) {
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(entities) << "Could not open persist journal" << _filename << "-" << file.errorString();
+        return false;
+    }
+
+    qint64 size = file.size();
+    QByteArray versions = journalVersions();
+    if (size < JOURNAL_HEADER_SIZE) {
+        qCWarning(entities) << "Persist journal" << _filename << "is too short to be a journal";
+        return false;
+    }
+
+    // the mapping goes away when the file is closed
+    const uchar* data = file.map(0, size);
+    if (!data) {
+        qCWarning(entities) << "Could not map persist journal" << _filename << "-" << file.errorString();
+        return false;
+    }
+
+    if (memcmp(data, versions.constData(), JOURNAL_VERSIONS_SIZE) != 0) {
+        qCDebug(entities) << "Persist journal" << _filename << "is from another format or entity version, ignoring it";
+        return false;
+    }
+
+    // find the last commit, anything after it is from a write that didn't finish
+    qint64 committedSize = 0;
+    QUuid committedID;
+    int64_t committedVersion = -1;
+
+    qint64 offset = JOURNAL_HEADER_SIZE;
+    uint8_t type;
+    qint64 payloadLength;
+    while (readRecord(data, size, offset, type, payloadLength)) {
+        const uchar* payload = data + offset + RECORD_HEADER_SIZE;
+        offset += RECORD_HEADER_SIZE + payloadLength;
+
+        if (type == COMMIT_RECORD && payloadLength == COMMIT_INFO_SIZE) {
+            readCommitInfo(payload, committedID, committedVersion);
+            committedSize = offset;
+        } else if (type != ENTITY_RECORD && type != DELETE_RECORD) {
+            break;
+        }
+    }
+
+    // the commit record decides, the header can be a write behind if the server stopped between the two
+    if (committedSize == 0) {
+        qCWarning(entities) << "Persist journal" << _filename << "has no complete commit";
+        return false;
+    }
+
+    // the payload offset and length of the last record of each entity, a zero length for deleted entities
+    QHash<EntityItemID, std::pair<qint64, qint64>> latest;
+    offset = JOURNAL_HEADER_SIZE;
+    while (offset < committedSize && readRecord(data, size, offset, type, payloadLength)) {
+        qint64 payloadOffset = offset + RECORD_HEADER_SIZE;
+        offset = payloadOffset + payloadLength;
+
+        if ((type == ENTITY_RECORD || type == DELETE_RECORD) && payloadLength >= NUM_BYTES_RFC4122_UUID) {
+            EntityItemID entityID(QUuid::fromRfc4122(QByteArray::fromRawData((const char*)data + payloadOffset,
+                                                                             NUM_BYTES_RFC4122_UUID)));
+            latest[entityID] = { payloadOffset, type == ENTITY_RECORD ? payloadLength : 0 };
+        }
+    }
+
+    // decode everything before touching the tree, so a bad record leaves the tree for the JSON file
+    struct LiveRecord {
+        EntityItemID entityID;
+        qint64 offset;
+        int length;
+    };
+    std::vector<LiveRecord> liveRecords;
+    liveRecords.reserve(latest.size());
+    QHash<EntityItemID, qint64> records;
+    qint64 liveBytes = 0;
+    for (auto it = latest.cbegin(); it != latest.cend(); ++it) {
+        int entityLength = (int)it.value().second;
+        if (entityLength > 0) {
+            liveRecords.push_back({ it.key(), it.value().first, entityLength });
+            records[it.key()] = RECORD_HEADER_SIZE + entityLength;
+            liveBytes += RECORD_HEADER_SIZE + entityLength;
+        }
+    }
+
+    // each record decodes on its own, so spread them over the worker threads
+    std::vector<EntityItemPointer> loadedEntities(liveRecords.size());
+    std::atomic<bool> decodeFailed { false };
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, liveRecords.size(), DECODES_PER_TASK),
+                      [&](const tbb::blocked_range<size_t>& range) {
+        ReadBitstreamToTreeParams args;
+        for (size_t i = range.begin(); i != range.end() && !decodeFailed; ++i) {
+            const LiveRecord& record = liveRecords[i];
+            const unsigned char* entityData = data + record.offset;
+            EntityItemPointer entity = EntityTypes::constructEntityItem(entityData, record.length, args);
+            if (!entity || entity->readEntityDataFromBuffer(entityData, record.length, args) <= 0) {
+                qCWarning(entities) << "Could not decode entity" << record.entityID << "from persist journal" << _filename;
+                decodeFailed = true;
+                return;
+            }
+            if (entity->getCreated() == UNKNOWN_CREATED_TIME) {
+                entity->recordCreationTime();
+            }
+            loadedEntities[i] = entity;
+        }
+    });
+    if (decodeFailed) {
+        return false;
+    }
+
+    // add them the way entities decoded from an entity data packet are added
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    tree.setDeferParentFixups(true);
+    for (const auto& entity : loadedEntities) {
+        AddEntityOperator theOperator(tree.getThisPointer(), entity);
+        tree.recurseTreeWithOperator(&theOperator);
+        tree.postAddEntity(entity);
+
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        }
+    }
+    tree.setDeferParentFixups(false);
+
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = tree.findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
+
+    persistID = committedID;
+    dataVersion = committedVersion;
+
+    _records = records;
+    _liveBytes = liveBytes;
+    _fileSize = committedSize;
+    _lastWriteTime = usecTimestampNow();
+    _needsRewrite = false;
+    _appendsSinceCompaction = 0;
+
+    qCDebug(entities) << "Loaded" << loadedEntities.size() << "entities from persist journal" << _filename
+        << "at" << persistID << dataVersion;
+    return true;
+}
+
+bool EntityPersistJournal::shouldCompact() const {
+    if (_appendsSinceCompaction >= MAX_APPENDS_BETWEEN_COMPACTIONS) {
+        return true;
+    }
+    return _fileSize > MIN_COMPACTION_FILE_SIZE && _fileSize > MAX_JOURNAL_OVERHEAD * (JOURNAL_HEADER_SIZE + _liveBytes);
+}
+
+bool EntityPersistJournal::write(EntityTree& tree, const QUuid& persistID, int64_t dataVersion) {
+    quint64 writeStarted = usecTimestampNow();
+    bool compact = _needsRewrite || shouldCompact();
+
+    QSet<EntityItemID> live;
+    live.reserve(_records.size());
+    std::vector<EntityItemPointer> changed;
+
+    // only gather the changes under the tree lock, they are encoded after it is released
+    tree.withReadLock([&] {
+        tree.recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            auto entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+            entityTreeElement->forEachEntity([&](EntityItemPointer entity) {
+                if (!entity->isParentIDValid()) {
+                    return; // these aren't saved to the JSON file either
+                }
+
+                EntityItemID entityID = entity->getEntityItemID();
+                live.insert(entityID);
+
+                if (compact || !_records.contains(entityID) || entity->getLastChangedOnServer() >= _lastWriteTime) {
+                    changed.push_back(entity);
+                }
+            });
+            return true;
+        });
+    });
+
+    QByteArray buffer;
+    QHash<EntityItemID, qint64> written;
+    for (const auto& entity : changed) {
+        QByteArray entityData = entity->getPersistData();
+        if (entityData.isEmpty()) {
+            qCWarning(entities) << "Could not encode entity" << entity->getEntityItemID() << "for persist journal" << _filename;
+
+            // what is on disk no longer matches the tree
+            _needsRewrite = true;
+            return false;
+        }
+        appendRecord(buffer, ENTITY_RECORD, entityData);
+        written[entity->getEntityItemID()] = RECORD_HEADER_SIZE + entityData.size();
+    }
+
+    QVector<EntityItemID> deleted;
+    if (!compact) {
+        for (auto it = _records.cbegin(); it != _records.cend(); ++it) {
+            if (!live.contains(it.key())) {
+                appendRecord(buffer, DELETE_RECORD, it.key().toRfc4122());
+                deleted.push_back(it.key());
+            }
+        }
+    }
+    appendCommitRecord(buffer, persistID, dataVersion);
+
+    bool success = false;
+    if (compact) {
+        QByteArray header = journalVersions() + commitInfo(persistID, dataVersion);
+        QSaveFile file(_filename);
+        success = file.open(QIODevice::WriteOnly) && file.write(header) == header.size() &&
+            file.write(buffer) == buffer.size() && file.commit();
+        if (success) {
+            qCDebug(entities) << "Rewrote persist journal" << _filename << "with" << written.size() << "entities,"
+                << _fileSize << "bytes ->" << (header.size() + buffer.size()) << "bytes";
+
+            _records = written;
+            _liveBytes = 0;
+            for (auto recordSize : _records) {
+                _liveBytes += recordSize;
+            }
+            _fileSize = header.size() + buffer.size();
+            _appendsSinceCompaction = 0;
+        }
+    } else {
+        QFile file(_filename);
+        success = file.open(QIODevice::ReadWrite);
+
+        // drop anything after the last commit, left by a write that didn't finish
+        if (success && file.size() != _fileSize) {
+            success = file.resize(_fileSize);
+        }
+        success = success && file.seek(_fileSize) && file.write(buffer) == buffer.size() && file.flush();
+
+        // only once the commit is written, so the header is never ahead of it
+        QByteArray info = commitInfo(persistID, dataVersion);
+        success = success && file.seek(JOURNAL_VERSIONS_SIZE) && file.write(info) == info.size() && file.flush();
+        if (success) {
+            for (auto it = written.cbegin(); it != written.cend(); ++it) {
+                _liveBytes += it.value() - _records.value(it.key(), 0);
+                _records[it.key()] = it.value();
+            }
+            for (const auto& entityID : deleted) {
+                _liveBytes -= _records.take(entityID);
+            }
+            _fileSize += buffer.size();
+            ++_appendsSinceCompaction;
+        }
+    }
+
+    if (!success) {
+        qCWarning(entities) << "Failed to write persist journal" << _filename;
+        _needsRewrite = true;
+        return false;
+    }
+
+    _needsRewrite = false;
+    _lastWriteTime = writeStarted;
+    return true;
+}
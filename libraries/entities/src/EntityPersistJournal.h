@@ -0,0 +1,69 @@
+//
+//  EntityPersistJournal.h
+//  libraries/entities/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPersistJournal_h
+#define hifi_EntityPersistJournal_h
+
+#include <cstdint>
+
+#include <QHash>
+#include <QString>
+#include <QUuid>
+
+#include "EntityItemID.h"
+
+class EntityTree;
+
+// Append-only binary persistence of the entities of an EntityTree
+//   The journal is a header followed by records. An entity record holds the full bitstream encoding of an entity,
+//   the one sent to clients, whose property flags index the properties that follow. A delete record holds the ID of
+//   an entity that is gone, and a commit record closes each write with the persist ID and data version it is at.
+//   The header repeats the persist ID and data version of the last commit, so they can be read without the records.
+//   Loading maps the file and decodes the last record of each entity up to the last commit, without going through
+//   JSON. Each write appends only the entities changed on the server since the previous write, and the journal is
+//   rewritten with only the live entities once most of it is superseded records.
+class EntityPersistJournal {
+public:
+    EntityPersistJournal(const QString& filename) : _filename(filename) {}
+
+    const QString& getFilename() const { return _filename; }
+
+    /// Reads the persist ID and data version from the header of the journal at filename. Returns false if there is
+    /// no journal there or it is from another format or entity version.
+    static bool readInfo(const QString& filename, QUuid& persistID, int64_t& dataVersion);
+
+    /// Adds the entities of the last commit to the tree and returns the persist ID and data version of that commit.
+    /// The caller must hold the tree's write lock. Returns false, without changing the tree, if the journal is
+    /// missing or can't be decoded.
+    bool load(EntityTree& tree, QUuid& persistID, int64_t& dataVersion);
+
+    /// Appends the entities changed since the last write and commits them with the persist ID and data version,
+    /// or rewrites the journal if it hasn't been loaded or written yet or is due for compaction.
+    bool write(EntityTree& tree, const QUuid& persistID, int64_t dataVersion);
+
+    qint64 getFileSize() const { return _fileSize; }
+    qint64 getLiveBytes() const { return _liveBytes; }
+    int getNumEntities() const { return _records.size(); }
+
+private:
+    bool shouldCompact() const;
+
+    QString _filename;
+
+    bool _needsRewrite { true }; // until the journal on disk is known to match the tree
+    QHash<EntityItemID, qint64> _records; // size of the live record of each journaled entity
+    qint64 _fileSize { 0 }; // up to the end of the last commit
+    qint64 _liveBytes { 0 };
+    quint64 _lastWriteTime { 0 };
+    int _appendsSinceCompaction { 0 };
+};
+
+#endif // hifi_EntityPersistJournal_h
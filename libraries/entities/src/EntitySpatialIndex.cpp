@@ -0,0 +1,143 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndex.h"
+
+#include <algorithm>
+
+const float EntitySpatialIndex::DEFAULT_CELL_SIZE = 8.0f; // meters
+
+// element cubes that would cover more cells than this are checked by every query instead
+const int64_t MAX_CELLS_PER_ENTRY = 64;
+
+// cell coordinates are packed into 21 bits each
+const int CELL_COORDINATE_BITS = 21;
+const int CELL_COORDINATE_OFFSET = 1 << (CELL_COORDINATE_BITS - 1);
+const uint64_t CELL_COORDINATE_MASK = (1 << CELL_COORDINATE_BITS) - 1;
+
+glm::ivec3 EntitySpatialIndex::cellFor(const glm::vec3& position) const {
+    glm::vec3 cell = glm::floor(position / _cellSize);
+    cell = glm::clamp(cell, glm::vec3((float)(-CELL_COORDINATE_OFFSET)), glm::vec3((float)(CELL_COORDINATE_OFFSET - 1)));
+    return glm::ivec3(cell);
+}
+
+EntitySpatialIndex::CellKey EntitySpatialIndex::keyFor(const glm::ivec3& cell) {
+    return ((uint64_t)(cell.x + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) |
+        (((uint64_t)(cell.y + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) << CELL_COORDINATE_BITS) |
+        (((uint64_t)(cell.z + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) << (2 * CELL_COORDINATE_BITS));
+}
+
+glm::ivec3 EntitySpatialIndex::cellFromKey(CellKey key) {
+    return glm::ivec3((int)(key & CELL_COORDINATE_MASK) - CELL_COORDINATE_OFFSET,
+                      (int)((key >> CELL_COORDINATE_BITS) & CELL_COORDINATE_MASK) - CELL_COORDINATE_OFFSET,
+                      (int)((key >> (2 * CELL_COORDINATE_BITS)) & CELL_COORDINATE_MASK) - CELL_COORDINATE_OFFSET);
+}
+
+void EntitySpatialIndex::insert(const EntityItemPointer& entity, const AACube& elementCube) {
+    if (!entity) {
+        return;
+    }
+
+    // an entity is only ever in one element at a time, so this replaces any entry it already has
+    remove(entity.get());
+
+    Entry entry;
+    entry.entity = entity;
+    entry.elementCube = elementCube;
+    entry.minCell = cellFor(elementCube.getMinimumPoint());
+    entry.maxCell = cellFor(elementCube.getMaximumPoint());
+
+    glm::i64vec3 span = glm::i64vec3(entry.maxCell - entry.minCell) + glm::i64vec3(1);
+    entry.oversized = span.x * span.y * span.z > MAX_CELLS_PER_ENTRY;
+
+    withWriteLock([&] {
+        const EntityItem* entityItem = entity.get();
+        if (entry.oversized) {
+            _oversized.push_back(entityItem);
+        } else {
+            glm::ivec3 cell;
+            for (cell.z = entry.minCell.z; cell.z <= entry.maxCell.z; ++cell.z) {
+                for (cell.y = entry.minCell.y; cell.y <= entry.maxCell.y; ++cell.y) {
+                    for (cell.x = entry.minCell.x; cell.x <= entry.maxCell.x; ++cell.x) {
+                        _cells[keyFor(cell)].push_back(entityItem);
+                    }
+                }
+            }
+        }
+        _entries.emplace(entityItem, std::move(entry));
+    });
+}
+
+void EntitySpatialIndex::remove(const EntityItem* entity) {
+    withWriteLock([&] {
+        auto it = _entries.find(entity);
+        if (it == _entries.end()) {
+            return;
+        }
+
+        const Entry& entry = it->second;
+        auto eraseFrom = [&](std::vector<const EntityItem*>& entities) {
+            auto found = std::find(entities.begin(), entities.end(), entity);
+            if (found != entities.end()) {
+                // order within a cell doesn't matter
+                *found = entities.back();
+                entities.pop_back();
+            }
+        };
+
+        if (entry.oversized) {
+            eraseFrom(_oversized);
+        } else {
+            glm::ivec3 cell;
+            for (cell.z = entry.minCell.z; cell.z <= entry.maxCell.z; ++cell.z) {
+                for (cell.y = entry.minCell.y; cell.y <= entry.maxCell.y; ++cell.y) {
+                    for (cell.x = entry.minCell.x; cell.x <= entry.maxCell.x; ++cell.x) {
+                        auto cellIt = _cells.find(keyFor(cell));
+                        if (cellIt != _cells.end()) {
+                            eraseFrom(cellIt->second);
+                            if (cellIt->second.empty()) {
+                                _cells.erase(cellIt);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        _entries.erase(it);
+    });
+}
+
+void EntitySpatialIndex::clear() {
+    withWriteLock([&] {
+        _entries.clear();
+        _cells.clear();
+        _oversized.clear();
+    });
+}
+
+size_t EntitySpatialIndex::size() const {
+    return resultWithReadLock<size_t>([&] {
+        return _entries.size();
+    });
+}
+
+size_t EntitySpatialIndex::numOccupiedCells() const {
+    return resultWithReadLock<size_t>([&] {
+        return _cells.size();
+    });
+}
+
+size_t EntitySpatialIndex::numOversized() const {
+    return resultWithReadLock<size_t>([&] {
+        return _oversized.size();
+    });
+}
@@ -0,0 +1,126 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <AACube.h>
+#include <shared/ReadWriteLockable.h>
+
+#include "EntityItem.h"
+
+// Flat hashed uniform grid over the cubes of the octree elements that hold each entity.
+//   An entity never leaves the cube of its element, so a query that gathers the entities whose element
+//   cube touches the query bounds, then tests each entity, finds the same entities the octree recursion does
+//   without walking the element hierarchy. The EntityTree keeps it up to date as entities are added to and
+//   removed from elements. Elements too large for the grid are kept in a list checked by every query.
+class EntitySpatialIndex : public ReadWriteLockable {
+public:
+    static const float DEFAULT_CELL_SIZE;
+
+    EntitySpatialIndex(float cellSize = DEFAULT_CELL_SIZE) : _cellSize(cellSize) {}
+
+    void insert(const EntityItemPointer& entity, const AACube& elementCube);
+    void remove(const EntityItem* entity);
+    void clear();
+
+    size_t size() const;
+    size_t numOccupiedCells() const;
+    size_t numOversized() const;
+
+    // calls f(entity, elementCube) once for every entity whose element cube may touch bounds
+    template <typename F>
+    void forEachCandidate(const AABox& bounds, F f) const;
+
+private:
+    using CellKey = uint64_t;
+
+    struct Entry {
+        EntityItemPointer entity;
+        AACube elementCube;
+        glm::ivec3 minCell;
+        glm::ivec3 maxCell;
+        bool oversized { false };
+    };
+
+    glm::ivec3 cellFor(const glm::vec3& position) const;
+    static CellKey keyFor(const glm::ivec3& cell);
+    static glm::ivec3 cellFromKey(CellKey key);
+
+    template <typename F>
+    void visitCell(const std::vector<const EntityItem*>& cellEntities, const glm::ivec3& cell,
+                   const glm::ivec3& queryMinCell, F& f) const;
+
+    float _cellSize;
+    std::unordered_map<const EntityItem*, Entry> _entries;
+    std::unordered_map<CellKey, std::vector<const EntityItem*>> _cells;
+    std::vector<const EntityItem*> _oversized;
+};
+
+template <typename F>
+void EntitySpatialIndex::visitCell(const std::vector<const EntityItem*>& cellEntities, const glm::ivec3& cell,
+                                   const glm::ivec3& queryMinCell, F& f) const {
+    for (auto entityItem : cellEntities) {
+        const Entry& entry = _entries.at(entityItem);
+
+        // an entry spans several cells, only report it from the first of those cells this query visits
+        if (glm::max(entry.minCell, queryMinCell) == cell) {
+            f(entry.entity, entry.elementCube);
+        }
+    }
+}
+
+template <typename F>
+void EntitySpatialIndex::forEachCandidate(const AABox& bounds, F f) const {
+    withReadLock([&] {
+        for (auto entityItem : _oversized) {
+            const Entry& entry = _entries.at(entityItem);
+            f(entry.entity, entry.elementCube);
+        }
+
+        glm::ivec3 minCell = cellFor(bounds.getMinimumPoint());
+        glm::ivec3 maxCell = cellFor(bounds.getMaximumPoint());
+        glm::i64vec3 span = glm::i64vec3(maxCell - minCell) + glm::i64vec3(1);
+        int64_t numQueryCells = span.x * span.y * span.z;
+
+        if (numQueryCells > (int64_t)_cells.size()) {
+            // the query covers more cells than are occupied, so just walk the occupied ones
+            for (const auto& cellEntities : _cells) {
+                glm::ivec3 cell = cellFromKey(cellEntities.first);
+                if (glm::all(glm::greaterThanEqual(cell, minCell)) && glm::all(glm::lessThanEqual(cell, maxCell))) {
+                    visitCell(cellEntities.second, cell, minCell, f);
+                }
+            }
+            return;
+        }
+
+        glm::ivec3 cell;
+        for (cell.z = minCell.z; cell.z <= maxCell.z; ++cell.z) {
+            for (cell.y = minCell.y; cell.y <= maxCell.y; ++cell.y) {
+                for (cell.x = minCell.x; cell.x <= maxCell.x; ++cell.x) {
+                    auto it = _cells.find(keyFor(cell));
+                    if (it != _cells.end()) {
+                        visitCell(it->second, cell, minCell, f);
+                    }
+                }
+            }
+        }
+    });
+}
+
+#endif // hifi_EntitySpatialIndex_h
@@ -10,6 +10,9 @@
 //
 
 #include "EntityTree.h"
+
+#include <algorithm>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
 #include <openssl/err.h>
@@ -26,6 +29,7 @@
 #include <Extents.h>
 #include <PerfStat.h>
 #include <Profile.h>
+#include <TBBHelpers.h>
 
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
@@ -34,13 +38,14 @@
 #include "UpdateEntityOperator.h"
 #include "QVariantGLM.h"
 #include "EntitiesLogging.h"
-#include "RecurseOctreeToMapOperator.h"
+#include "EntityTreeSnapshot.h"
 #include "LogHandler.h"
 #include "EntityEditFilters.h"
 #include "EntityDynamicFactoryInterface.h"
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
+const uint64_t EntityTree::DEFAULT_EDIT_COALESCING_WINDOW = 0; // usecs, edits are only held when a window is configured
 
 // combines the ray cast arguments into a single object
 class RayArgs {
@@ -87,9 +92,11 @@ public:
 
 
 EntityTree::EntityTree(bool shouldReaverage) :
-    Octree(shouldReaverage)
+    Octree(shouldReaverage),
+    _spatialIndex(new EntitySpatialIndex())
 {
     resetClientEditStats();
+    _editCoalescingWindows.fill(DEFAULT_EDIT_COALESCING_WINDOW);
 
     EntityItem::retrieveMarketplacePublicKey();
 }
@@ -131,6 +138,9 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
         }
     });
     localMap.clear();
+    if (_spatialIndex) {
+        _spatialIndex->clear();
+    }
     Octree::eraseAllOctreeElements(createNewRoot);
 
     resetClientEditStats();
@@ -261,6 +271,14 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
     }
 }
 
+void EntityTree::setDeferParentFixups(bool deferParentFixups) {
+    bool wasDeferred = _deferParentFixups;
+    _deferParentFixups = deferParentFixups;
+    if (wasDeferred && !deferParentFixups) {
+        fixupNeedsParentFixups();
+    }
+}
+
 /// Adds a new entity item to the tree
 void EntityTree::postAddEntity(EntityItemPointer entity) {
     assert(entity);
@@ -301,7 +319,9 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     _isDirty = true;
 
     // find and hook up any entities with this entity as a (previously) missing parent
-    fixupNeedsParentFixups();
+    if (!_deferParentFixups) {
+        fixupNeedsParentFixups();
+    }
 
     emit addingEntity(entity->getEntityItemID());
 }
@@ -319,7 +339,7 @@ bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProp
 }
 
 bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperties& origProperties,
-        const SharedNodePointer& senderNode) {
+        const SharedNodePointer& senderNode, bool inPlace) {
     EntityTreeElementPointer containingElement = entity->getElement();
     if (!containingElement) {
         return false;
@@ -455,17 +475,24 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         } else {
             newQueryAACube = entity->getQueryAACube();
         }
-        UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
-        recurseTreeWithOperator(&theOperator);
+        if (inPlace) {
+            // canApplyEditInPlace already made sure this edit leaves the entity, and any children, where they are
+            markChangedInPlace(containingElement);
+        } else {
+            UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
+            recurseTreeWithOperator(&theOperator);
+        }
         if (entity->setProperties(properties)) {
             emit editingEntityPointer(entity);
         }
 
         // if the entity has children, run UpdateEntityOperator on them.  If the children have children, recurse
         QQueue<SpatiallyNestablePointer> toProcess;
-        foreach (SpatiallyNestablePointer child, entity->getChildren()) {
-            if (child && child->getNestableType() == NestableType::Entity) {
-                toProcess.enqueue(child);
+        if (!inPlace) {
+            foreach (SpatiallyNestablePointer child, entity->getChildren()) {
+                if (child && child->getNestableType() == NestableType::Entity) {
+                    toProcess.enqueue(child);
+                }
             }
         }
 
@@ -980,6 +1007,20 @@ bool EntityTree::findInSphereOperation(const OctreeElementPointer& element, void
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities) {
+    if (_spatialIndex) {
+        QVector<EntityItemPointer> entities;
+        AABox bounds(center - glm::vec3(radius), 2.0f * radius);
+        _spatialIndex->forEachCandidate(bounds, [&](const EntityItemPointer& entity, const AACube& elementCube) {
+            glm::vec3 penetration;
+            if (elementCube.findSpherePenetration(center, radius, penetration) &&
+                    EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+                entities.push_back(entity);
+            }
+        });
+        foundEntities.swap(entities);
+        return;
+    }
+
     FindAllNearPointArgs args = { center, radius, QVector<EntityItemPointer>() };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInSphereOperation, &args);
@@ -1010,6 +1051,17 @@ bool EntityTree::findInCubeOperation(const OctreeElementPointer& element, void*
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
+    if (_spatialIndex) {
+        QVector<EntityItemPointer> entities;
+        _spatialIndex->forEachCandidate(AABox(cube), [&](const EntityItemPointer& entity, const AACube& elementCube) {
+            if (elementCube.touches(cube) && EntityTreeElement::entityTouchesCube(entity, cube)) {
+                entities.push_back(entity);
+            }
+        });
+        foundEntities.swap(entities);
+        return;
+    }
+
     FindEntitiesInCubeArgs args(cube);
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInCubeOperation, &args);
@@ -1039,6 +1091,17 @@ bool EntityTree::findInBoxOperation(const OctreeElementPointer& element, void* e
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
+    if (_spatialIndex) {
+        QVector<EntityItemPointer> entities;
+        _spatialIndex->forEachCandidate(box, [&](const EntityItemPointer& entity, const AACube& elementCube) {
+            if (elementCube.touches(box) && EntityTreeElement::entityTouchesBox(entity, box)) {
+                entities.push_back(entity);
+            }
+        });
+        foundEntities.swap(entities);
+        return;
+    }
+
     FindEntitiesInBoxArgs args(box);
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInBoxOperation, &args);
@@ -1064,6 +1127,30 @@ bool EntityTree::findInFrustumOperation(const OctreeElementPointer& element, voi
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities) {
+    if (_spatialIndex) {
+        // bound the frustum by its corners and its keyhole
+        glm::vec3 minimum = frustum.getPosition() - glm::vec3(frustum.getCenterRadius());
+        glm::vec3 maximum = frustum.getPosition() + glm::vec3(frustum.getCenterRadius());
+        for (const auto& corner : { frustum.getNearTopLeft(), frustum.getNearTopRight(),
+                                    frustum.getNearBottomLeft(), frustum.getNearBottomRight(),
+                                    frustum.getFarTopLeft(), frustum.getFarTopRight(),
+                                    frustum.getFarBottomLeft(), frustum.getFarBottomRight() }) {
+            minimum = glm::min(minimum, corner);
+            maximum = glm::max(maximum, corner);
+        }
+
+        QVector<EntityItemPointer> entities;
+        _spatialIndex->forEachCandidate(AABox(minimum, maximum - minimum), [&](const EntityItemPointer& entity,
+                                                                               const AACube& elementCube) {
+            if (frustum.calculateCubeKeyholeIntersection(elementCube) != ViewFrustum::OUTSIDE &&
+                    EntityTreeElement::entityTouchesFrustum(entity, frustum)) {
+                entities.push_back(entity);
+            }
+        });
+        foundEntities.swap(entities);
+        return;
+    }
+
     FindInFrustumArgs args = { frustum, QVector<EntityItemPointer>() };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInFrustumOperation, &args);
@@ -1077,6 +1164,38 @@ void EntityTree::findEntities(RecurseOctreeOperation& elementFilter,
     recurseTreeWithOperation(elementFilter, nullptr);
 }
 
+void EntityTree::setUseSpatialIndex(bool useSpatialIndex) {
+    withWriteLock([&] {
+        if (!useSpatialIndex) {
+            _spatialIndex.reset();
+        } else if (!_spatialIndex) {
+            _spatialIndex.reset(new EntitySpatialIndex());
+
+            // index everything already in the tree
+            recurseTreeWithOperation([](const OctreeElementPointer& element, void* extraData) {
+                auto spatialIndex = static_cast<EntitySpatialIndex*>(extraData);
+                EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+                entityTreeElement->forEachEntity([&](EntityItemPointer entity) {
+                    spatialIndex->insert(entity, element->getAACube());
+                });
+                return true;
+            }, _spatialIndex.get());
+        }
+    });
+}
+
+void EntityTree::entityAddedToElement(const EntityItemPointer& entity, const AACube& elementCube) {
+    if (_spatialIndex) {
+        _spatialIndex->insert(entity, elementCube);
+    }
+}
+
+void EntityTree::entityRemovedFromElement(const EntityItem* entity) {
+    if (_spatialIndex) {
+        _spatialIndex->remove(entity);
+    }
+}
+
 EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
     EntityItemID entityID(id);
     return findEntityByEntityItemID(entityID);
@@ -1537,8 +1656,290 @@ void EntityTree::processChallengeOwnershipPacket(ReceivedMessage& message, const
     }
 }
 
+bool EntityTree::canApplyEditInPlace(const ReceivedMessage& message, const unsigned char* editData, int maxLength) {
+    PacketType packetType = message.getType();
+    if (packetType != PacketType::EntityEdit && packetType != PacketType::EntityPhysics) {
+        return false;
+    }
+
+    // a filter is free to change any property, including the ones that would move the entity
+    if (_hasEntityEditFilter) {
+        return false;
+    }
+
+    EntityItemID entityID;
+    EntityPropertyFlags propertyFlags;
+    if (!EntityItemProperties::decodeEntityEditPacketHeader(editData, maxLength, entityID, propertyFlags)) {
+        return false;
+    }
+
+    // these re-parent the entity, run UpdateEntityOperator for a lock change, or reload entity scripts
+    static const EntityPropertyList STRUCTURAL_PROPERTIES[] = {
+        PROP_PARENT_ID, PROP_PARENT_JOINT_INDEX, PROP_LOCKED, PROP_SCRIPT, PROP_SCRIPT_TIMESTAMP, PROP_SERVER_SCRIPTS
+    };
+    for (auto property : STRUCTURAL_PROPERTIES) {
+        if (propertyFlags.getHasProperty(property)) {
+            return false;
+        }
+    }
+
+    // unknown entities are rejected by processEditPacketData, let it do that with the usual locking
+    EntityItemPointer entity = findEntityByEntityItemID(entityID);
+    if (!entity) {
+        return false;
+    }
+    EntityTreeElementPointer containingElement = entity->getElement();
+    if (!containingElement) {
+        return false;
+    }
+
+    static const EntityPropertyList SPATIAL_PROPERTIES[] = {
+        PROP_POSITION, PROP_ROTATION, PROP_DIMENSIONS, PROP_REGISTRATION_POINT, PROP_QUERY_AA_CUBE
+    };
+    bool isSpatialEdit = false;
+    for (auto property : SPATIAL_PROPERTIES) {
+        isSpatialEdit = isSpatialEdit || propertyFlags.getHasProperty(property);
+    }
+    if (!isSpatialEdit) {
+        return true;
+    }
+
+    // moving a parent moves its children, which would need to be re-sorted too
+    if (entity->hasChildren()) {
+        return false;
+    }
+
+    // the entity stays in its element as long as that element is the best fit for its query cube,
+    // see UpdateEntityOperator
+    bool success;
+    AACube queryCube = entity->getQueryAACube(success);
+    if (!success || !containingElement->bestFitBounds(queryCube.clamp((float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE))) {
+        return false;
+    }
+    if (propertyFlags.getHasProperty(PROP_QUERY_AA_CUBE)) {
+        int bytesRead;
+        EntityItemID decodedID;
+        EntityItemProperties properties;
+        if (!EntityItemProperties::decodeEntityEditPacket(editData, maxLength, bytesRead, decodedID, properties)) {
+            return false;
+        }
+        AABox newQueryBox = properties.getQueryAACube().clamp((float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE);
+        if (!containingElement->bestFitBounds(newQueryBox)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void EntityTree::markChangedInPlace(const EntityTreeElementPointer& element) {
+    // mark the path down to the element the way UpdateEntityOperator would, without pruning or adding elements
+    const AACube& elementCube = element->getAACube();
+    OctreeElementPointer pathElement = _rootElement;
+    while (pathElement) {
+        pathElement->markWithChangedTime();
+        if (pathElement == element) {
+            break;
+        }
+
+        OctreeElementPointer nextElement;
+        pathElement->forEachChild([&](int childIndex, const OctreeElementPointer& child) {
+            if (!nextElement && child->getAACube().contains(elementCube)) {
+                nextElement = child;
+            }
+        });
+        pathElement = nextElement;
+    }
+    element->bumpChangedContent();
+}
+
+bool EntityTree::processInPlaceEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                              const SharedNodePointer& senderNode, int& bytesRead) {
+    if (!getIsServer() || !canApplyEditInPlace(message, editData, maxLength)) {
+        return false;
+    }
+
+    // the entity takes its own write lock as its properties are set, readers of the tree are never blocked
+    bytesRead = applyEditPacketData(message, editData, maxLength, senderNode, true);
+    return true;
+}
+
+void EntityTree::setEditCoalescingWindow(uint64_t window) {
+    _editCoalescingWindows.fill(window);
+}
+
+void EntityTree::setEditCoalescingWindow(EntityTypes::EntityType entityType, uint64_t window) {
+    _editCoalescingWindows[entityType] = window;
+}
+
+static bool hasAllProperties(const EntityPropertyFlags& propertyFlags, const EntityPropertyFlags& otherFlags) {
+    for (int property = PROP_PAGED_PROPERTY; property < PROP_AFTER_LAST_ITEM; ++property) {
+        if (otherFlags.getHasProperty((EntityPropertyList)property) &&
+            !propertyFlags.getHasProperty((EntityPropertyList)property)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void EntityTree::releaseHeldEdit(const EntityItemID& entityID, std::vector<HeldEdit>& readyEdits) {
+    auto it = _heldEdits.find(entityID);
+    if (it != _heldEdits.end()) {
+        readyHeldEdit(*it, readyEdits);
+        _heldEdits.erase(it);
+    }
+}
+
+void EntityTree::readyHeldEdit(HeldEntityEdit& heldEdit, std::vector<HeldEdit>& readyEdits) {
+    readyEdits.push_back(heldEdit.edit);
+
+    // the entry keeps the message, and so the edit data it is found by, until the edit is applied
+    auto editData = reinterpret_cast<const unsigned char*>(heldEdit.edit.message->getRawMessage()) + heldEdit.edit.offset;
+    _releasedEdits[editData] = std::move(heldEdit);
+}
+
+bool EntityTree::takeReleasedEdit(const unsigned char* editData, int& processedBytes, EntityItemID& entityID,
+                                  EntityItemProperties& properties) {
+    std::lock_guard<std::mutex> lock(_heldEditsMutex);
+    auto it = _releasedEdits.find(editData);
+    if (it == _releasedEdits.end()) {
+        return false;
+    }
+    processedBytes = it->edit.length;
+    entityID = it->entityID;
+    properties = std::move(it->properties);
+    _releasedEdits.erase(it);
+    return true;
+}
+
+void EntityTree::releaseHeldEdits(bool releaseAll, std::vector<HeldEdit>& readyEdits) {
+    std::lock_guard<std::mutex> lock(_heldEditsMutex);
+    if (_heldEdits.isEmpty()) {
+        return;
+    }
+
+    uint64_t now = usecTimestampNow();
+    std::vector<HeldEntityEdit> dueEdits;
+    for (auto it = _heldEdits.begin(); it != _heldEdits.end();) {
+        if (releaseAll || it->releaseAt <= now) {
+            dueEdits.push_back(std::move(*it));
+            it = _heldEdits.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::sort(dueEdits.begin(), dueEdits.end(), [](const HeldEntityEdit& a, const HeldEntityEdit& b) {
+        return a.heldAt < b.heldAt;
+    });
+    for (auto& dueEdit : dueEdits) {
+        readyHeldEdit(dueEdit, readyEdits);
+    }
+}
+
+uint64_t EntityTree::getNextHeldEditRelease() const {
+    std::lock_guard<std::mutex> lock(_heldEditsMutex);
+    uint64_t nextRelease = 0;
+    for (const auto& heldEdit : _heldEdits) {
+        if (nextRelease == 0 || heldEdit.releaseAt < nextRelease) {
+            nextRelease = heldEdit.releaseAt;
+        }
+    }
+    return nextRelease;
+}
+
+bool EntityTree::holdEditPacketData(const QSharedPointer<ReceivedMessage>& message, const unsigned char* editData,
+                                    int maxLength, const SharedNodePointer& senderNode, int& bytesRead,
+                                    std::vector<HeldEdit>& readyEdits) {
+    if (!getIsServer()) {
+        return false;
+    }
+
+    PacketType packetType = message->getType();
+    if (packetType != PacketType::EntityEdit && packetType != PacketType::EntityPhysics) {
+        // adds, clones and erases see all the edits that arrived before them
+        releaseHeldEdits(true, readyEdits);
+        return false;
+    }
+
+    EntityItemID entityID;
+    EntityPropertyFlags propertyFlags;
+    if (!EntityItemProperties::decodeEntityEditPacketHeader(editData, maxLength, entityID, propertyFlags)) {
+        return false;
+    }
+
+    // a new parent may have held edits of its own
+    if (propertyFlags.getHasProperty(PROP_PARENT_ID) || propertyFlags.getHasProperty(PROP_PARENT_JOINT_INDEX)) {
+        releaseHeldEdits(true, readyEdits);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_heldEditsMutex);
+
+    // a filter sees every edit, bids for simulation ownership are arbitrated in the order they arrive,
+    // and the other structural edits are rare enough not to bother
+    static const EntityPropertyList UNHELD_PROPERTIES[] = {
+        PROP_SIMULATION_OWNER, PROP_LOCKED, PROP_SCRIPT, PROP_SCRIPT_TIMESTAMP, PROP_SERVER_SCRIPTS
+    };
+    bool canHold = !_hasEntityEditFilter;
+    for (auto property : UNHELD_PROPERTIES) {
+        canHold = canHold && !propertyFlags.getHasProperty(property);
+    }
+
+    uint64_t window = 0;
+    if (canHold) {
+        EntityItemPointer entity = findEntityByEntityItemID(entityID);
+        window = entity ? _editCoalescingWindows[entity->getType()] : 0;
+    }
+
+    HeldEntityEdit heldEdit;
+    int processedBytes = 0;
+    if (window > 0 && !EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes,
+                                                                    heldEdit.entityID, heldEdit.properties)) {
+        window = 0;
+    }
+
+    if (window == 0) {
+        // this edit is applied now, so the one before it has to be applied first
+        releaseHeldEdit(entityID, readyEdits);
+        return false;
+    }
+
+    heldEdit.edit.message = message;
+    heldEdit.edit.offset = (int)(reinterpret_cast<const char*>(editData) - message->getRawMessage());
+    heldEdit.edit.length = processedBytes;
+    heldEdit.edit.sourceNode = senderNode;
+    heldEdit.packetType = packetType;
+    heldEdit.propertyFlags = propertyFlags;
+    heldEdit.heldAt = usecTimestampNow();
+    heldEdit.releaseAt = heldEdit.heldAt + window;
+
+    auto it = _heldEdits.find(entityID);
+    if (it != _heldEdits.end()) {
+        bool isSuperseded = it->edit.sourceNode == senderNode && it->packetType == packetType &&
+            hasAllProperties(propertyFlags, it->propertyFlags);
+        if (isSuperseded) {
+            // keep the release time of the edit it replaces, so an entity that is edited continuously
+            // is still updated once per window
+            heldEdit.heldAt = it->heldAt;
+            heldEdit.releaseAt = it->releaseAt;
+            _totalCoalescedEdits++;
+        } else {
+            readyHeldEdit(*it, readyEdits);
+        }
+    }
+    _heldEdits[entityID] = std::move(heldEdit);
+
+    bytesRead = processedBytes;
+    return true;
+}
+
 int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                      const SharedNodePointer& senderNode) {
+    return applyEditPacketData(message, editData, maxLength, senderNode, false);
+}
+
+int EntityTree::applyEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                    const SharedNodePointer& senderNode, bool inPlace) {
 
     if (!getIsServer()) {
         qCWarning(entities) << "EntityTree::processEditPacketData() should only be called on a server tree.";
@@ -1593,6 +1994,9 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                         properties = entityToClone->getProperties();
                     }
                 }
+            } else if (!isAdd && takeReleasedEdit(editData, processedBytes, entityItemID, properties)) {
+                // it was decoded when it was held
+                validEditPacket = true;
             } else {
                 validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
             }
@@ -1734,7 +2138,7 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                     if (!isPhysics) {
                         properties.setLastEditedBy(senderNode->getUUID());
                     }
-                    updateEntity(existingEntity, properties, senderNode);
+                    updateEntity(existingEntity, properties, senderNode, inPlace);
                     existingEntity->markAsChangedOnServer();
                     endUpdate = usecTimestampNow();
                     _totalUpdates++;
@@ -2484,15 +2888,45 @@ bool EntityTree::writeToMap(QVariantMap& entityDescription, OctreeElementPointer
     }
     entityDescription["DataVersion"] = _persistDataVersion;
     entityDescription["Id"] = _persistID;
-    QScriptEngine scriptEngine;
-    RecurseOctreeToMapOperator theOperator(entityDescription, element, &scriptEngine, skipDefaultValues,
-                                            skipThoseWithBadParents, _myAvatar);
-    withReadLock([&] {
-        recurseTreeWithOperator(&theOperator);
-    });
+
+    // only taking the snapshot holds the tree lock, the entities are converted to JSON after it is released
+    EntityTreeSnapshot snapshot(*this, element, skipDefaultValues, skipThoseWithBadParents);
+    QVariantList entities = entityDescription["Entities"].toList();
+    snapshot.appendTo(entities, _myAvatar);
+    entityDescription["Entities"] = entities;
+    return true;
+}
+
+bool EntityTree::readPersistJournalInfo(const QString& filename, OctreeUtils::RawOctreeData& data) const {
+    if (!EntityPersistJournal::readInfo(filename, data.id, data.dataVersion)) {
+        return false;
+    }
+
+    // the journal is only readable by the entity version that wrote it
+    data.version = expectedVersion();
+    return true;
+}
+
+bool EntityTree::readFromPersistJournal(const QString& filename) {
+    QUuid persistID;
+    int64_t dataVersion;
+    _persistJournal.reset(new EntityPersistJournal(filename));
+    if (!_persistJournal->load(*this, persistID, dataVersion)) {
+        return false;
+    }
+
+    _persistID = persistID;
+    _persistDataVersion = dataVersion;
     return true;
 }
 
+bool EntityTree::writeToPersistJournal(const QString& filename) {
+    if (!_persistJournal || _persistJournal->getFilename() != filename) {
+        _persistJournal.reset(new EntityPersistJournal(filename));
+    }
+    return _persistJournal->write(*this, _persistID, _persistDataVersion);
+}
+
 void convertGrabUserDataToProperties(EntityItemProperties& properties) {
     GrabPropertyGroup& grabProperties = properties.getGrab();
     QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
@@ -2633,45 +3067,37 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     // to a QScriptValue, and then to EntityItemProperties.  These properties are used
     // to add the new entity to the EntityTree.
     QVariantList entitiesQList = map["Entities"].toList();
-    QScriptEngine scriptEngine;
 
     if (entitiesQList.length() == 0) {
         // Empty map or invalidly formed file.
         return false;
     }
 
-    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    // Converting is most of the time spent loading and each entity converts on its own, so the conversions run in
+    // parallel, each task with a script engine of its own. Adding to the tree stays on this thread. Entities are
+    // converted and added in batches, so that only one batch of converted properties is held at a time.
+    struct ConvertedEntity {
+        EntityItemID entityItemID;
+        EntityItemProperties properties;
+        QString parentJointName;
+    };
 
-    bool success = true;
-    foreach (QVariant entityVariant, entitiesQList) {
+    auto convertEntity = [&](const QVariantMap& entityMap, QScriptEngine& scriptEngine, ConvertedEntity& converted) {
         // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
-        QVariantMap entityMap = entityVariant.toMap();
-
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
-
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
-
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
-        }
+        EntityItemProperties& properties = converted.properties;
 
         QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
         EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
 
-        EntityItemID entityItemID;
         if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+            converted.entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
         } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
+            converted.entityItemID = EntityItemID(QUuid::createUuid());
         }
 
-        if (properties.getClientOnly()) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
+        // handle parentJointName for wearables once we're back on the thread that owns the avatar
+        if (entityMap.contains("parentJointName") && entityMap.contains("parentID")) {
+            converted.parentJointName = entityMap["parentJointName"].toString();
         }
 
         // Fix for older content not containing mode fields in the zones
@@ -2760,21 +3186,65 @@ bool EntityTree::readFromMap(QVariantMap& map) {
             properties.setAlphaSpread(0.0f);
             properties.setColorSpread({0, 0, 0});
         }
+    };
 
-        EntityItemPointer entity = addEntity(entityItemID, properties);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
-            success = false;
-        }
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
 
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+    // look for the parents of all the loaded entities at once, instead of after each add
+    setDeferParentFixups(true);
+
+    const int ENTITIES_PER_BATCH = 4096;
+    const int CONVERSIONS_PER_TASK = 256;
+    std::vector<ConvertedEntity> convertedEntities;
+
+    bool success = true;
+    for (int batchStart = 0; batchStart < entitiesQList.size(); batchStart += ENTITIES_PER_BATCH) {
+        const int batchEnd = std::min(batchStart + ENTITIES_PER_BATCH, entitiesQList.size());
+        convertedEntities.clear();
+        convertedEntities.resize(batchEnd - batchStart);
+
+        tbb::parallel_for(tbb::blocked_range<int>(batchStart, batchEnd, CONVERSIONS_PER_TASK),
+                          [&](const tbb::blocked_range<int>& range) {
+            QScriptEngine scriptEngine;
+            for (int i = range.begin(); i < range.end(); ++i) {
+                convertEntity(entitiesQList.at(i).toMap(), scriptEngine, convertedEntities[i - batchStart]);
+            }
+        });
+
+        for (auto& converted : convertedEntities) {
+            const EntityItemID& entityItemID = converted.entityItemID;
+            EntityItemProperties& properties = converted.properties;
+
+            if (_myAvatar && !converted.parentJointName.isEmpty() && properties.getParentID() == AVATAR_SELF_ID) {
+                properties.setParentJointIndex(_myAvatar->getJointIndex(converted.parentJointName));
+
+                qCDebug(entities) << "Found parentJointName " << converted.parentJointName <<
+                    " mapped it to parentJointIndex " << properties.getParentJointIndex();
+            }
+
+            if (properties.getClientOnly()) {
+                auto nodeList = DependencyManager::get<NodeList>();
+                const QUuid myNodeID = nodeList->getSessionUUID();
+                properties.setOwningAvatarID(myNodeID);
+            }
+
+            EntityItemPointer entity = addEntity(entityItemID, properties);
+            if (!entity) {
+                qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+                success = false;
+            }
+
+            if (entity) {
+                const QUuid& cloneOriginID = entity->getCloneOriginID();
+                if (!cloneOriginID.isNull()) {
+                    cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+                }
             }
         }
     }
 
+    setDeferParentFixups(false);
+
     for (const auto& entityID : cloneIDs.keys()) {
         auto entity = findEntityByID(entityID);
         if (entity) {
@@ -12,6 +12,10 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <array>
+#include <atomic>
+#include <mutex>
+
 #include <QSet>
 #include <QVector>
 
@@ -20,6 +24,8 @@
 
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
+#include "EntitySpatialIndex.h"
+#include "EntityPersistJournal.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
 
@@ -88,6 +94,29 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual bool processInPlaceEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                              const SharedNodePointer& senderNode, int& bytesRead) override;
+    virtual bool holdEditPacketData(const QSharedPointer<ReceivedMessage>& message, const unsigned char* editData,
+                                    int maxLength, const SharedNodePointer& senderNode, int& bytesRead,
+                                    std::vector<HeldEdit>& readyEdits) override;
+    virtual void releaseHeldEdits(bool releaseAll, std::vector<HeldEdit>& readyEdits) override;
+    virtual uint64_t getNextHeldEditRelease() const override;
+
+    // Edits of an entity are held for the window of its type, and dropped if another edit from the same sender
+    // sets at least the same properties before then, so a moving entity is updated and sent once per window.
+    // A window of 0 applies the edits of that type as they arrive. Holding is off by default: it trades up to a
+    // window of latency on every held edit for fewer updates, which only pays off for entities edited continuously.
+    static const uint64_t DEFAULT_EDIT_COALESCING_WINDOW; // usecs
+    void setEditCoalescingWindow(uint64_t window);
+    void setEditCoalescingWindow(EntityTypes::EntityType entityType, uint64_t window);
+    uint64_t getEditCoalescingWindow(EntityTypes::EntityType entityType) const { return _editCoalescingWindows[entityType]; }
+
+    // The flat index the findEntities spatial queries use instead of recursing the octree. It is on by default and
+    // kept up to date by EntityTreeElement as entities are added to and removed from elements.
+    void setUseSpatialIndex(bool useSpatialIndex);
+    bool getUseSpatialIndex() const { return (bool)_spatialIndex; }
+    void entityAddedToElement(const EntityItemPointer& entity, const AACube& elementCube);
+    void entityRemovedFromElement(const EntityItem* entity);
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -117,6 +146,9 @@ public:
     // The newer API...
     void postAddEntity(EntityItemPointer entityItem);
 
+    // While set, postAddEntity leaves entities with missing parents to be hooked up all at once when it is cleared
+    void setDeferParentFixups(bool deferParentFixups);
+
     EntityItemPointer addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone = false);
 
     // use this method if you only know the entityID
@@ -224,6 +256,9 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
+    virtual bool readPersistJournalInfo(const QString& filename, OctreeUtils::RawOctreeData& data) const override;
+    virtual bool readFromPersistJournal(const QString& filename) override;
+    virtual bool writeToPersistJournal(const QString& filename) override;
 
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
@@ -237,14 +272,18 @@ public:
         _totalUpdateTime = 0;
         _totalCreateTime = 0;
         _totalLoggingTime = 0;
+        _totalCoalescedEdits = 0;
     }
 
-    virtual quint64 getAverageDecodeTime() const override { return _totalEditMessages == 0 ? 0 : _totalDecodeTime / _totalEditMessages; }
-    virtual quint64 getAverageLookupTime() const override { return _totalEditMessages == 0 ? 0 : _totalLookupTime / _totalEditMessages; }
-    virtual quint64 getAverageUpdateTime() const override { return _totalUpdates == 0 ? 0 : _totalUpdateTime / _totalUpdates; }
-    virtual quint64 getAverageCreateTime() const override { return _totalCreates == 0 ? 0 : _totalCreateTime / _totalCreates; }
-    virtual quint64 getAverageLoggingTime() const override { return _totalEditMessages == 0 ? 0 : _totalLoggingTime / _totalEditMessages; }
-    virtual quint64 getAverageFilterTime() const override { return _totalEditMessages == 0 ? 0 : _totalFilterTime / _totalEditMessages; }
+    // each total is read once, so a reset from another thread can't leave a count of 0 to divide by
+    static quint64 getAverage(quint64 total, int count) { return count == 0 ? 0 : total / count; }
+    virtual quint64 getAverageDecodeTime() const override { return getAverage(_totalDecodeTime, _totalEditMessages); }
+    virtual quint64 getAverageLookupTime() const override { return getAverage(_totalLookupTime, _totalEditMessages); }
+    virtual quint64 getAverageUpdateTime() const override { return getAverage(_totalUpdateTime, _totalUpdates); }
+    virtual quint64 getAverageCreateTime() const override { return getAverage(_totalCreateTime, _totalCreates); }
+    virtual quint64 getAverageLoggingTime() const override { return getAverage(_totalLoggingTime, _totalEditMessages); }
+    virtual quint64 getAverageFilterTime() const override { return getAverage(_totalFilterTime, _totalEditMessages); }
+    virtual quint64 getTotalCoalescedEdits() const override { return _totalCoalescedEdits; }
 
     void trackIncomingEntityLastEdited(quint64 lastEditedTime, int bytesRead);
     quint64 getAverageEditDeltas() const
@@ -317,8 +356,10 @@ signals:
 protected:
 
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
+    // inPlace is for edits canApplyEditInPlace allowed, which leave the entity and its children where they are in the
+    // tree, so they are applied under the read lock
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
-            const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
+            const SharedNodePointer& senderNode = SharedNodePointer(nullptr), bool inPlace = false);
     static bool findNearPointOperation(const OctreeElementPointer& element, void* extraData);
     static bool findInSphereOperation(const OctreeElementPointer& element, void* extraData);
     static bool findInCubeOperation(const OctreeElementPointer& element, void* extraData);
@@ -365,16 +406,18 @@ protected:
     bool _wantTerseEditLogging = false;
 
 
-    // some performance tracking properties - only used in server trees
-    int _totalEditMessages = 0;
-    int _totalUpdates = 0;
-    int _totalCreates = 0;
-    quint64 _totalDecodeTime = 0;
-    quint64 _totalLookupTime = 0;
-    quint64 _totalUpdateTime = 0;
-    quint64 _totalCreateTime = 0;
-    quint64 _totalLoggingTime = 0;
-    quint64 _totalFilterTime = 0;
+    // some performance tracking properties - only used in server trees, edits applied in place update them under
+    // the read lock while the stats are read from other threads
+    std::atomic<int> _totalEditMessages { 0 };
+    std::atomic<int> _totalUpdates { 0 };
+    std::atomic<int> _totalCreates { 0 };
+    std::atomic<quint64> _totalDecodeTime { 0 };
+    std::atomic<quint64> _totalLookupTime { 0 };
+    std::atomic<quint64> _totalUpdateTime { 0 };
+    std::atomic<quint64> _totalCreateTime { 0 };
+    std::atomic<quint64> _totalLoggingTime { 0 };
+    std::atomic<quint64> _totalFilterTime { 0 };
+    std::atomic<quint64> _totalCoalescedEdits { 0 };
 
     // these performance statistics are only used in the client
     void resetClientEditStats();
@@ -395,6 +438,32 @@ protected:
     float _maxTmpEntityLifetime { DEFAULT_MAX_TMP_ENTITY_LIFETIME };
 
     bool filterProperties(EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType);
+
+    bool canApplyEditInPlace(const ReceivedMessage& message, const unsigned char* editData, int maxLength);
+    int applyEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                            const SharedNodePointer& senderNode, bool inPlace);
+    void markChangedInPlace(const EntityTreeElementPointer& element);
+    std::unique_ptr<EntitySpatialIndex> _spatialIndex;
+    std::unique_ptr<EntityPersistJournal> _persistJournal;
+    bool _deferParentFixups { false };
+
+    struct HeldEntityEdit {
+        HeldEdit edit;
+        PacketType packetType;
+        EntityPropertyFlags propertyFlags;
+        uint64_t heldAt;
+        uint64_t releaseAt;
+        EntityItemID entityID;
+        EntityItemProperties properties; // decoded when the edit was held, so it isn't decoded again to apply it
+    };
+    void releaseHeldEdit(const EntityItemID& entityID, std::vector<HeldEdit>& readyEdits);
+    void readyHeldEdit(HeldEntityEdit& heldEdit, std::vector<HeldEdit>& readyEdits); // with _heldEditsMutex held
+    bool takeReleasedEdit(const unsigned char* editData, int& processedBytes, EntityItemID& entityID,
+                          EntityItemProperties& properties);
+    std::array<uint64_t, EntityTypes::LAST + 1> _editCoalescingWindows;
+    mutable std::mutex _heldEditsMutex;
+    QHash<EntityItemID, HeldEntityEdit> _heldEdits; // guarded by _heldEditsMutex
+    QHash<const unsigned char*, HeldEntityEdit> _releasedEdits; // by edit data until applied, guarded by _heldEditsMutex
     bool _hasEntityEditFilter{ false };
     QStringList _entityScriptSourceWhitelist;
 
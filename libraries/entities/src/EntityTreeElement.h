@@ -15,6 +15,7 @@
 #include <memory>
 
 #include <OctreeElement.h>
+#include <OctreeElementPool.h>
 #include <QList>
 
 #include "EntityEditPacketSender.h"
@@ -88,6 +89,11 @@ class EntityTreeElement : public OctreeElement, ReadWriteLockable {
 public:
     virtual ~EntityTreeElement();
 
+    // elements are carved out of a shared pool, so the elements of a tree sit together in memory
+    static void* operator new(size_t size);
+    static void operator delete(void* element, size_t size);
+    static const OctreeElementPool& getElementPool();
+
     // type safe versions of OctreeElement methods
     EntityTreeElementPointer getChildAtIndex(int index) const {
         return std::static_pointer_cast<EntityTreeElement>(OctreeElement::getChildAtIndex(index));
@@ -198,6 +204,12 @@ public:
     /// \param entities[out] vector of non-const EntityItemPointer
     void getEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities);
 
+    /// per entity tests used by the getEntities queries above, and by the EntitySpatialIndex
+    static bool entityTouchesSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
+    static bool entityTouchesCube(const EntityItemPointer& entity, const AACube& cube);
+    static bool entityTouchesBox(const EntityItemPointer& entity, const AABox& box);
+    static bool entityTouchesFrustum(const EntityItemPointer& entity, const ViewFrustum& frustum);
+
     /// finds all entities that match filter
     /// \param filter function that adds matching entities to foundEntities
     /// \param entities[out] vector of non-const EntityItemPointer
@@ -0,0 +1,62 @@
+//
+//  EntityTreeSnapshot.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeSnapshot.h"
+
+#include <QtScript/QScriptEngine>
+
+#include <AvatarData.h>
+
+#include "EntityTree.h"
+
+EntityTreeSnapshot::EntityTreeSnapshot(EntityTree& tree, const OctreeElementPointer& top, bool skipDefaultValues,
+                                       bool skipThoseWithBadParents) :
+    _skipDefaultValues(skipDefaultValues)
+{
+    tree.withReadLock([&] {
+        // if some element "top" was given, only save information for that element and its children
+        OctreeElementPointer start = top ? top : tree.getRoot();
+        tree.recurseElementWithOperation(start, [&](const OctreeElementPointer& element, void* extraData) {
+            auto entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+            entityTreeElement->forEachEntity([&](EntityItemPointer entity) {
+                if (skipThoseWithBadParents && !entity->isParentIDValid()) {
+                    return; // we weren't able to resolve a parent from _parentID, so don't save this entity.
+                }
+
+                _entries.push_back(entity->getProperties());
+            });
+            return true;
+        }, nullptr);
+    });
+}
+
+void EntityTreeSnapshot::appendTo(QVariantList& entities, const std::shared_ptr<AvatarData>& myAvatar) const {
+    QScriptEngine scriptEngine;
+    entities.reserve(entities.size() + (int)_entries.size());
+
+    for (const auto& properties : _entries) {
+        QScriptValue scriptValue = _skipDefaultValues ? EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, properties) :
+            EntityItemPropertiesToScriptValue(&scriptEngine, properties);
+
+        // handle parentJointName for wearables
+        if (myAvatar && properties.getParentID() == AVATAR_SELF_ID &&
+            properties.getParentJointIndex() != INVALID_JOINT_INDEX) {
+
+            auto jointNames = myAvatar->getJointNames();
+            auto parentJointIndex = properties.getParentJointIndex();
+            if (parentJointIndex < jointNames.count()) {
+                scriptValue.setProperty("parentJointName", jointNames.at(parentJointIndex));
+            }
+        }
+
+        entities << scriptValue.toVariant();
+    }
+}
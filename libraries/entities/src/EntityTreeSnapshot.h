@@ -0,0 +1,44 @@
+//
+//  EntityTreeSnapshot.h
+//  libraries/entities/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeSnapshot_h
+#define hifi_EntityTreeSnapshot_h
+
+#include <memory>
+#include <vector>
+
+#include <QVariantList>
+
+#include "EntityItem.h"
+#include "EntityItemProperties.h"
+
+class AvatarData;
+
+// The entities of an EntityTree at one point in time, to write to the JSON persist file without holding the tree lock
+//   Taking a snapshot holds the tree read lock only to copy the properties of every entity, which share their strings
+//   and arrays with the entity. The script conversion to JSON, which is most of the cost of a persist, happens after
+//   the lock is released, and edits made in the meantime aren't seen by it.
+class EntityTreeSnapshot {
+public:
+    EntityTreeSnapshot(EntityTree& tree, const OctreeElementPointer& top, bool skipDefaultValues,
+                       bool skipThoseWithBadParents);
+
+    int size() const { return (int)_entries.size(); }
+
+    /// Converts every entity in the snapshot to the JSON object the persist file stores, and appends it
+    void appendTo(QVariantList& entities, const std::shared_ptr<AvatarData>& myAvatar = nullptr) const;
+
+private:
+    std::vector<EntityItemProperties> _entries;
+    bool _skipDefaultValues;
+};
+
+#endif // hifi_EntityTreeSnapshot_h
@@ -51,6 +51,11 @@ public:
 
     virtual void downloadFinished(const QByteArray& data) override;
 
+    // the geometry this mapping points to loads with the priorities of the mapping
+    virtual void setLoadPriority(const QPointer<QObject>& owner, float priority) override;
+    virtual void setLoadPriorities(const QHash<QPointer<QObject>, float>& priorities) override;
+    virtual void clearLoadPriority(const QPointer<QObject>& owner) override;
+
 private slots:
     void onGeometryMappingLoaded(bool success);
 
@@ -112,6 +117,7 @@ void GeometryMappingResource::downloadFinished(const QByteArray& data) {
         _geometryResource = modelCache->getResource(url, QUrl(), &extra).staticCast<GeometryResource>();
         // Avoid caching nested resources - their references will be held by the parent
         _geometryResource->_isCacheable = false;
+        _geometryResource->setLoadPriorities(_loadPriorities);
 
         if (_geometryResource->isLoaded()) {
             onGeometryMappingLoaded(!_geometryResource->getURL().isEmpty());
@@ -126,6 +132,27 @@ void GeometryMappingResource::downloadFinished(const QByteArray& data) {
     }
 }
 
+void GeometryMappingResource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    GeometryResource::setLoadPriority(owner, priority);
+    if (_geometryResource) {
+        _geometryResource->setLoadPriority(owner, priority);
+    }
+}
+
+void GeometryMappingResource::setLoadPriorities(const QHash<QPointer<QObject>, float>& priorities) {
+    GeometryResource::setLoadPriorities(priorities);
+    if (_geometryResource) {
+        _geometryResource->setLoadPriorities(priorities);
+    }
+}
+
+void GeometryMappingResource::clearLoadPriority(const QPointer<QObject>& owner) {
+    GeometryResource::clearLoadPriority(owner);
+    if (_geometryResource) {
+        _geometryResource->clearLoadPriority(owner);
+    }
+}
+
 void GeometryMappingResource::onGeometryMappingLoaded(bool success) {
     if (success && _geometryResource) {
         _hfmModel = _geometryResource->_hfmModel;
@@ -428,6 +455,17 @@ bool Geometry::areTexturesLoaded() const {
     return true;
 }
 
+void Geometry::setTextureLoadPriority(const QPointer<QObject>& owner, float priority) {
+    // once loaded, a texture sets its own priorities for the mips that follow
+    for (auto& material : _materials) {
+        for (auto& texture : material->_textures) {
+            if (texture.texture && !texture.texture->isLoaded()) {
+                texture.texture->setLoadPriority(owner, priority);
+            }
+        }
+    }
+}
+
 const std::shared_ptr<NetworkMaterial> Geometry::getShapeMaterial(int partID) const {
     if ((partID >= 0) && (partID < (int)_meshParts->size())) {
         int materialID = _meshParts->at(partID)->materialID;
@@ -482,6 +520,12 @@ void GeometryResourceWatcher::setResource(GeometryResource::Pointer resource) {
     }
 }
 
+void GeometryResourceWatcher::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    if (_resource && !_resource->isLoaded()) {
+        _resource->setLoadPriority(owner, priority);
+    }
+}
+
 void GeometryResourceWatcher::resourceFinished(bool success) {
     if (success) {
         _geometryRef = std::make_shared<Geometry>(*_resource);
@@ -55,6 +55,10 @@ public:
     void setTextures(const QVariantMap& textureMap);
 
     virtual bool areTexturesLoaded() const;
+
+    /// Moves the textures that are still loading up or down the request queue.
+    void setTextureLoadPriority(const QPointer<QObject>& owner, float priority);
+
     const QUrl& getAnimGraphOverrideUrl() const { return _animGraphOverrideUrl; }
     const QVariantHash& getMapping() const { return _mapping; }
 
@@ -114,6 +118,9 @@ public:
 
     void setResource(GeometryResource::Pointer resource);
 
+    /// Moves a resource that is still loading up or down the request queue.
+    void setLoadPriority(const QPointer<QObject>& owner, float priority);
+
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
@@ -12,10 +12,18 @@
 #include "AssetClient.h"
 
 #include <cstdint>
+#include <memory>
 
 #include <QtCore/QBuffer>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QPointer>
+#include <QtCore/QRunnable>
+#include <QtCore/QSaveFile>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtScript/QScriptEngine>
 #include <QtNetwork/QNetworkDiskCache>
 
@@ -34,6 +42,8 @@
 
 MessageID AssetClient::_currentID = 0;
 
+static const QString CHUNK_INDEX_FILENAME = "assetChunks.index";
+
 AssetClient::AssetClient() {
     _cacheDir = qApp->property(hifi::properties::APP_LOCAL_DATA_PATH).toString();
     setCustomDeleter([](Dependency* dependency){
@@ -47,6 +57,8 @@ AssetClient::AssetClient() {
     packetReceiver.registerListener(PacketType::AssetGetInfoReply, this, "handleAssetGetInfoReply");
     packetReceiver.registerListener(PacketType::AssetGetReply, this, "handleAssetGetReply", true);
     packetReceiver.registerListener(PacketType::AssetUploadReply, this, "handleAssetUploadReply");
+    packetReceiver.registerListener(PacketType::AssetGetChunksReply, this, "handleAssetGetChunksReply");
+    packetReceiver.registerListener(PacketType::AssetFindChunksReply, this, "handleAssetFindChunksReply");
 
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &AssetClient::handleNodeKilled);
     connect(nodeList.data(), &LimitedNodeList::clientConnectionToNodeReset,
@@ -273,6 +285,10 @@ void AssetClient::clearCache() {
     if (auto cache = NetworkAccessManager::getInstance().cache()) {
         qInfo() << "AssetClient::clearCache(): Clearing disk cache.";
         cache->clear();
+
+        // the cached assets the chunks were read from are gone
+        _cachedChunks.clear();
+        QFile::remove(getChunkIndexPath());
     } else {
         qCWarning(asset_client) << "No disk cache to clear.";
     }
@@ -923,6 +939,489 @@ void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message
     }
 }
 
+MessageID AssetClient::getAssetChunks(const QString& hash, GetChunksCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto messageID = ++_currentID;
+
+        auto payloadSize = sizeof(messageID) + AssetUtils::SHA256_HASH_LENGTH;
+        auto packet = NLPacket::create(PacketType::AssetGetChunks, payloadSize, true);
+
+        packet->writePrimitive(messageID);
+        packet->write(QByteArray::fromHex(hash.toLatin1()));
+
+        if (nodeList->sendPacket(std::move(packet), *assetServer) != -1) {
+            _pendingChunkListRequests[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, {});
+    return INVALID_MESSAGE_ID;
+}
+
+void AssetClient::handleAssetGetChunksReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+    auto assetHash = message->read(AssetUtils::SHA256_HASH_LENGTH);
+
+    AssetUtils::AssetServerError error;
+    message->readPrimitive(&error);
+
+    // each chunk is sent as its length and its hash, its offset follows from the lengths of the ones before it
+    std::vector<AssetUtils::AssetChunk> chunks;
+    if (error == AssetUtils::AssetServerError::NoError) {
+        static const qint64 CHUNK_ENTRY_SIZE = sizeof(uint32_t) + AssetUtils::SHA256_HASH_LENGTH;
+
+        uint32_t numChunks = 0;
+        message->readPrimitive(&numChunks);
+        if ((qint64)numChunks * CHUNK_ENTRY_SIZE > message->getBytesLeftToRead()) {
+            qCWarning(asset_client) << "Got a truncated chunk list for" << assetHash.toHex();
+            error = AssetUtils::AssetServerError::FileOperationFailed;
+        } else {
+            chunks.reserve(numChunks);
+            AssetUtils::DataOffset offset = 0;
+            for (uint32_t i = 0; i < numChunks; ++i) {
+                uint32_t length;
+                message->readPrimitive(&length);
+                chunks.push_back({ offset, length, message->read(AssetUtils::SHA256_HASH_LENGTH) });
+                offset += length;
+            }
+        }
+    }
+
+    // Check if we have any pending requests for this node
+    auto messageMapIt = _pendingChunkListRequests.find(senderNode);
+    if (messageMapIt != _pendingChunkListRequests.end()) {
+
+        // Found the node, get the MessageID -> Callback map
+        auto& messageCallbackMap = messageMapIt->second;
+
+        // Check if we have this pending request
+        auto requestIt = messageCallbackMap.find(messageID);
+        if (requestIt != messageCallbackMap.end()) {
+            auto callback = requestIt->second;
+            messageCallbackMap.erase(requestIt);
+            callback(true, error, chunks);
+        }
+
+        // Although the messageCallbackMap may now be empty, we won't delete the node until we have disconnected from
+        // it to avoid constantly creating/deleting the map on subsequent requests.
+    }
+}
+
+MessageID AssetClient::findAssetChunks(const std::vector<AssetUtils::AssetChunk>& chunks, FindChunksCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto packetList = NLPacketList::create(PacketType::AssetFindChunks, QByteArray(), true, true);
+
+        auto messageID = ++_currentID;
+        packetList->writePrimitive(messageID);
+
+        packetList->writePrimitive((uint32_t)chunks.size());
+        for (const auto& chunk : chunks) {
+            packetList->write(chunk.hash);
+        }
+
+        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            _pendingFindChunksRequests[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, {});
+    return INVALID_MESSAGE_ID;
+}
+
+void AssetClient::handleAssetFindChunksReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetUtils::AssetServerError error;
+    message->readPrimitive(&error);
+
+    // one bit per chunk, set for the chunks the server holds
+    std::vector<bool> serverHasChunk;
+    if (error == AssetUtils::AssetServerError::NoError) {
+        uint32_t numChunks = 0;
+        message->readPrimitive(&numChunks);
+        auto foundBits = message->read((numChunks + 7) / 8);
+        if (foundBits.size() != (int)((numChunks + 7) / 8)) {
+            error = AssetUtils::AssetServerError::FileOperationFailed;
+        } else {
+            serverHasChunk.resize(numChunks);
+            for (uint32_t i = 0; i < numChunks; ++i) {
+                serverHasChunk[i] = (foundBits.at(i / 8) & (1 << (i % 8))) != 0;
+            }
+        }
+    }
+
+    // Check if we have any pending requests for this node
+    auto messageMapIt = _pendingFindChunksRequests.find(senderNode);
+    if (messageMapIt != _pendingFindChunksRequests.end()) {
+
+        // Found the node, get the MessageID -> Callback map
+        auto& messageCallbackMap = messageMapIt->second;
+
+        // Check if we have this pending request
+        auto requestIt = messageCallbackMap.find(messageID);
+        if (requestIt != messageCallbackMap.end()) {
+            auto callback = requestIt->second;
+            messageCallbackMap.erase(requestIt);
+            callback(true, error, serverHasChunk);
+        }
+
+        // Although the messageCallbackMap may now be empty, we won't delete the node until we have disconnected from
+        // it to avoid constantly creating/deleting the map on subsequent requests.
+    }
+}
+
+MessageID AssetClient::uploadAssetChunks(const QByteArray& data, const std::vector<AssetUtils::AssetChunk>& chunks,
+                                         const std::vector<bool>& serverHasChunk, UploadResultCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+    Q_ASSERT(chunks.size() == serverHasChunk.size());
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto packetList = NLPacketList::create(PacketType::AssetUploadChunks, QByteArray(), true, true);
+
+        auto messageID = ++_currentID;
+        packetList->writePrimitive(messageID);
+
+        uint64_t size = data.length();
+        packetList->writePrimitive(size);
+
+        // every chunk is listed, the data follows for the ones the server doesn't hold
+        packetList->writePrimitive((uint32_t)chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            packetList->writePrimitive((uint32_t)chunks[i].length);
+            packetList->write(chunks[i].hash);
+            packetList->writePrimitive((uint8_t)!serverHasChunk[i]);
+        }
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            if (!serverHasChunk[i]) {
+                packetList->write(data.constData() + chunks[i].offset, chunks[i].length);
+            }
+        }
+
+        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            _pendingUploads[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, QString());
+    return INVALID_MESSAGE_ID;
+}
+
+bool AssetClient::cancelGetAssetChunksRequest(MessageID id) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    for (auto& kv : _pendingChunkListRequests) {
+        if (kv.second.erase(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AssetClient::cancelFindAssetChunksRequest(MessageID id) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    for (auto& kv : _pendingFindChunksRequests) {
+        if (kv.second.erase(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AssetClient::hasChunkCache() const {
+    return NetworkAccessManager::getInstance().cache() != nullptr;
+}
+
+QString AssetClient::getChunkIndexPath() const {
+    // next to the disk cache, which only ever removes its own files
+    auto cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache());
+    return cache ? QDir(cache->cacheDirectory()).filePath(CHUNK_INDEX_FILENAME) : QString();
+}
+
+namespace {
+
+// runs the reads of the chunk index and of cached chunks on the global thread pool
+class ChunkCacheTask : public QRunnable {
+public:
+    ChunkCacheTask(std::function<void()> task) : _task(task) {}
+
+    void run() override { _task(); }
+
+private:
+    std::function<void()> _task;
+};
+
+struct ChunkRead {
+    AssetUtils::DataOffset offset; // in the asset that is asked for
+    AssetUtils::DataOffset cachedOffset; // in the cached asset that holds it
+    int64_t length;
+    QByteArray hash;
+};
+
+}
+
+// The chunk index is a file of records appended as assets are cached: the hash of the asset, the number of its chunks,
+// then the length and the hash of each chunk. Records of assets that were evicted from the cache are dropped on load.
+// It is read on the thread pool, with a disk cache of its own, since the one of the network access manager can only be
+// used on this thread.
+void AssetClient::loadChunkIndex() {
+    if (_isChunkIndexLoaded || _isChunkIndexLoading) {
+        return;
+    }
+
+    auto cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache());
+    if (!cache) {
+        finishLoadingChunkIndex({});
+        return;
+    }
+    _isChunkIndexLoading = true;
+
+    auto cacheDirectory = cache->cacheDirectory();
+    auto indexPath = getChunkIndexPath();
+    QPointer<AssetClient> self = this;
+
+    QThreadPool::globalInstance()->start(new ChunkCacheTask([self, cacheDirectory, indexPath] {
+        QNetworkDiskCache diskCache;
+        diskCache.setCacheDirectory(cacheDirectory);
+
+        std::vector<std::pair<QByteArray, CachedChunk>> cachedChunks;
+        QFile file { indexPath };
+        if (file.open(QIODevice::ReadOnly)) {
+            QByteArray keptRecords;
+            int numDroppedRecords = 0;
+            QDataStream stream { &file };
+            while (!stream.atEnd()) {
+                QByteArray assetHash((int)AssetUtils::SHA256_HASH_LENGTH, '\0');
+                quint32 numChunks = 0;
+                if (stream.readRawData(assetHash.data(), assetHash.size()) != assetHash.size()) {
+                    break;
+                }
+                stream >> numChunks;
+
+                QByteArray record = assetHash;
+                QDataStream recordStream { &record, QIODevice::Append };
+                recordStream << numChunks;
+
+                std::vector<AssetUtils::AssetChunk> chunks;
+                AssetUtils::DataOffset offset = 0;
+                for (quint32 i = 0; i < numChunks && stream.status() == QDataStream::Ok; ++i) {
+                    quint32 length = 0;
+                    QByteArray chunkHash((int)AssetUtils::SHA256_HASH_LENGTH, '\0');
+                    stream >> length;
+                    if (stream.readRawData(chunkHash.data(), chunkHash.size()) != chunkHash.size()) {
+                        stream.setStatus(QDataStream::ReadPastEnd);
+                        break;
+                    }
+                    recordStream << length;
+                    recordStream.writeRawData(chunkHash.constData(), chunkHash.size());
+                    chunks.push_back({ offset, length, chunkHash });
+                    offset += length;
+                }
+                if (stream.status() != QDataStream::Ok) {
+                    // the last record was cut short
+                    ++numDroppedRecords;
+                    break;
+                }
+
+                AssetUtils::AssetHash hexHash = assetHash.toHex();
+                if (!diskCache.metaData(AssetUtils::getATPUrl(hexHash)).isValid()) {
+                    ++numDroppedRecords;
+                    continue;
+                }
+
+                for (const auto& chunk : chunks) {
+                    cachedChunks.push_back({ chunk.hash, { hexHash, chunk.offset } });
+                }
+                keptRecords.append(record);
+            }
+            file.close();
+
+            // records are only appended once the index is loaded, so nothing is lost here
+            if (numDroppedRecords > 0) {
+                QSaveFile compactedFile { indexPath };
+                if (compactedFile.open(QIODevice::WriteOnly)) {
+                    compactedFile.write(keptRecords);
+                    compactedFile.commit();
+                }
+            }
+        }
+
+        if (self) {
+            QMetaObject::invokeMethod(self, [self, cachedChunks] {
+                if (self) {
+                    self->finishLoadingChunkIndex(cachedChunks);
+                }
+            }, Qt::QueuedConnection);
+        }
+    }));
+}
+
+void AssetClient::finishLoadingChunkIndex(const std::vector<std::pair<QByteArray, CachedChunk>>& cachedChunks) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    _isChunkIndexLoading = false;
+    _isChunkIndexLoaded = true;
+
+    // chunks of assets cached while the index was loading are newer than the ones in the file
+    for (const auto& cachedChunk : cachedChunks) {
+        if (!_cachedChunks.contains(cachedChunk.first)) {
+            _cachedChunks.insert(cachedChunk.first, cachedChunk.second);
+        }
+    }
+
+    auto pendingRecords = std::move(_pendingChunkIndexRecords);
+    _pendingChunkIndexRecords.clear();
+    for (const auto& record : pendingRecords) {
+        appendToChunkIndex(record.first, record.second);
+    }
+
+    auto pendingLoads = std::move(_pendingChunkLoads);
+    _pendingChunkLoads.clear();
+    for (const auto& pendingLoad : pendingLoads) {
+        loadChunksFromCache(pendingLoad.first, pendingLoad.second);
+    }
+}
+
+void AssetClient::addChunksToCacheIndex(const AssetUtils::AssetHash& hash,
+                                        const std::vector<AssetUtils::AssetChunk>& chunks) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    if (chunks.empty()) {
+        return;
+    }
+
+    for (const auto& chunk : chunks) {
+        // the newest asset is the one least likely to be evicted
+        _cachedChunks.insert(chunk.hash, { hash, chunk.offset });
+    }
+
+    if (_isChunkIndexLoaded) {
+        appendToChunkIndex(hash, chunks);
+    } else {
+        // the file may be rewritten while it loads
+        _pendingChunkIndexRecords.push_back({ hash, chunks });
+        loadChunkIndex();
+    }
+}
+
+void AssetClient::appendToChunkIndex(const AssetUtils::AssetHash& hash, const std::vector<AssetUtils::AssetChunk>& chunks) {
+    // a record is a few KB at most, small enough to write from this thread
+    QFile file { getChunkIndexPath() };
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return;
+    }
+
+    QDataStream stream { &file };
+    auto assetHash = QByteArray::fromHex(hash.toLatin1());
+    stream.writeRawData(assetHash.constData(), assetHash.size());
+    stream << (quint32)chunks.size();
+    for (const auto& chunk : chunks) {
+        stream << (quint32)chunk.length;
+        stream.writeRawData(chunk.hash.constData(), chunk.hash.size());
+    }
+}
+
+void AssetClient::loadChunksFromCache(const std::vector<AssetUtils::AssetChunk>& chunks, LoadChunksCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache());
+    if (!cache) {
+        callback({});
+        return;
+    }
+
+    if (!_isChunkIndexLoaded) {
+        _pendingChunkLoads.push_back({ chunks, callback });
+        loadChunkIndex();
+        return;
+    }
+
+    // group the chunks by the cached asset that holds them, so each of those is opened once
+    std::map<AssetUtils::AssetHash, std::vector<ChunkRead>> chunksByAsset;
+    for (const auto& chunk : chunks) {
+        auto it = _cachedChunks.find(chunk.hash);
+        if (it != _cachedChunks.end()) {
+            chunksByAsset[it.value().hash].push_back({ chunk.offset, it.value().offset, chunk.length, chunk.hash });
+        }
+    }
+
+    if (chunksByAsset.empty()) {
+        callback({});
+        return;
+    }
+
+    // reading and hashing the chunks of a large asset would hold up every transfer on this thread
+    auto cacheDirectory = cache->cacheDirectory();
+    QPointer<AssetClient> self = this;
+
+    QThreadPool::globalInstance()->start(new ChunkCacheTask([self, cacheDirectory, chunksByAsset, callback] {
+        QNetworkDiskCache diskCache;
+        diskCache.setCacheDirectory(cacheDirectory);
+
+        std::map<AssetUtils::DataOffset, QByteArray> loadedChunks;
+        std::vector<std::pair<QByteArray, AssetUtils::AssetHash>> staleChunks;
+        for (const auto& assetChunks : chunksByAsset) {
+            // the cached file is memory mapped, only the chunks that are asked for are read
+            std::unique_ptr<QIODevice> device { diskCache.data(AssetUtils::getATPUrl(assetChunks.first)) };
+
+            for (const auto& chunk : assetChunks.second) {
+                QByteArray chunkBytes;
+                if (device && device->seek(chunk.cachedOffset)) {
+                    chunkBytes = device->read(chunk.length);
+                }
+
+                // the asset may have been evicted from the cache since it was indexed
+                if (chunkBytes.size() == chunk.length && AssetUtils::hashData(chunkBytes) == chunk.hash) {
+                    loadedChunks[chunk.offset] = chunkBytes;
+                } else {
+                    staleChunks.push_back({ chunk.hash, assetChunks.first });
+                }
+            }
+        }
+
+        if (self) {
+            QMetaObject::invokeMethod(self, [self, loadedChunks, staleChunks, callback] {
+                if (!self) {
+                    return;
+                }
+                for (const auto& staleChunk : staleChunks) {
+                    // unless a newer asset has been indexed for it since
+                    auto it = self->_cachedChunks.find(staleChunk.first);
+                    if (it != self->_cachedChunks.end() && it.value().hash == staleChunk.second) {
+                        self->_cachedChunks.erase(it);
+                    }
+                }
+                callback(loadedChunks);
+            }, Qt::QueuedConnection);
+        }
+    }));
+}
+
 void AssetClient::handleNodeKilled(SharedNodePointer node) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -961,16 +1460,19 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
     {
         auto messageMapIt = _pendingRequests.find(node);
         if (messageMapIt != _pendingRequests.end()) {
-            for (const auto& value : messageMapIt->second) {
+            // a failed part cancels the other parts of its asset, so the callbacks are not called from the map itself
+            auto requests = std::move(messageMapIt->second);
+            messageMapIt->second.clear();
+            for (const auto& value : requests) {
                 auto& message = value.second.message;
                 if (message) {
                     // Disconnect from all signals emitting from the pending message
                     disconnect(message.data(), nullptr, this, nullptr);
                 }
-
+            }
+            for (const auto& value : requests) {
                 value.second.completeCallback(false, AssetUtils::AssetServerError::NoError, QByteArray());
             }
-            messageMapIt->second.clear();
         }
     }
 
@@ -978,10 +1480,11 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
         auto messageMapIt = _pendingInfoRequests.find(node);
         if (messageMapIt != _pendingInfoRequests.end()) {
             AssetInfo info { "", 0 };
-            for (const auto& value : messageMapIt->second) {
+            auto callbacks = std::move(messageMapIt->second);
+            messageMapIt->second.clear();
+            for (const auto& value : callbacks) {
                 value.second(false, AssetUtils::AssetServerError::NoError, info);
             }
-            messageMapIt->second.clear();
         }
     }
 
@@ -994,4 +1497,26 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
             messageMapIt->second.clear();
         }
     }
+
+    {
+        auto messageMapIt = _pendingChunkListRequests.find(node);
+        if (messageMapIt != _pendingChunkListRequests.end()) {
+            auto callbacks = std::move(messageMapIt->second);
+            messageMapIt->second.clear();
+            for (const auto& value : callbacks) {
+                value.second(false, AssetUtils::AssetServerError::NoError, {});
+            }
+        }
+    }
+
+    {
+        auto messageMapIt = _pendingFindChunksRequests.find(node);
+        if (messageMapIt != _pendingFindChunksRequests.end()) {
+            auto callbacks = std::move(messageMapIt->second);
+            messageMapIt->second.clear();
+            for (const auto& value : callbacks) {
+                value.second(false, AssetUtils::AssetServerError::NoError, {});
+            }
+        }
+    }
 }
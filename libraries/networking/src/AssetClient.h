@@ -12,11 +12,13 @@
 #ifndef hifi_AssetClient_h
 #define hifi_AssetClient_h
 
+#include <QHash>
 #include <QStandardItemModel>
 #include <QtQml/QJSEngine>
 #include <QString>
 
 #include <map>
+#include <vector>
 
 #include <DependencyManager.h>
 #include <shared/MiniPromises.h>
@@ -46,6 +48,9 @@ using MappingOperationCallback = std::function<void(bool responseReceived, Asset
 using ReceivedAssetCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data)>;
 using GetInfoCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info)>;
 using UploadResultCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const QString& hash)>;
+using GetChunksCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const std::vector<AssetUtils::AssetChunk>& chunks)>;
+using FindChunksCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const std::vector<bool>& serverHasChunk)>;
+using LoadChunksCallback = std::function<void(const std::map<AssetUtils::DataOffset, QByteArray>& chunks)>;
 using ProgressCallback = std::function<void(qint64 totalReceived, qint64 total)>;
 
 class AssetClient : public QObject, public Dependency {
@@ -78,6 +83,8 @@ private slots:
     void handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetGetChunksReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetFindChunksReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void handleNodeKilled(SharedNodePointer node);
     void handleNodeClientConnectionReset(SharedNodePointer node);
@@ -95,10 +102,37 @@ private:
                   ReceivedAssetCallback callback, ProgressCallback progressCallback);
     MessageID uploadAsset(const QByteArray& data, UploadResultCallback callback);
 
+    MessageID getAssetChunks(const QString& hash, GetChunksCallback callback);
+    MessageID findAssetChunks(const std::vector<AssetUtils::AssetChunk>& chunks, FindChunksCallback callback);
+    MessageID uploadAssetChunks(const QByteArray& data, const std::vector<AssetUtils::AssetChunk>& chunks,
+                                const std::vector<bool>& serverHasChunk, UploadResultCallback callback);
+
     bool cancelMappingRequest(MessageID id);
     bool cancelGetAssetInfoRequest(MessageID id);
     bool cancelGetAssetRequest(MessageID id);
     bool cancelUploadAssetRequest(MessageID id);
+    bool cancelGetAssetChunksRequest(MessageID id);
+    bool cancelFindAssetChunksRequest(MessageID id);
+
+    /// Chunks can only be found in other assets when there is a disk cache
+    bool hasChunkCache() const;
+
+    /// Reads the chunks that assets in the disk cache already hold on the thread pool, then calls back on this thread
+    /// with their data by their offset in the asset
+    void loadChunksFromCache(const std::vector<AssetUtils::AssetChunk>& chunks, LoadChunksCallback callback);
+
+    /// Remember the chunks of an asset saved to the disk cache, so later versions of it only fetch the chunks that changed
+    void addChunksToCacheIndex(const AssetUtils::AssetHash& hash, const std::vector<AssetUtils::AssetChunk>& chunks);
+
+    struct CachedChunk {
+        AssetUtils::AssetHash hash; // of the cached asset that holds the chunk
+        AssetUtils::DataOffset offset;
+    };
+
+    void loadChunkIndex();
+    void finishLoadingChunkIndex(const std::vector<std::pair<QByteArray, CachedChunk>>& cachedChunks);
+    void appendToChunkIndex(const AssetUtils::AssetHash& hash, const std::vector<AssetUtils::AssetChunk>& chunks);
+    QString getChunkIndexPath() const;
 
     void handleProgressCallback(const QWeakPointer<Node>& node, MessageID messageID, qint64 size, AssetUtils::DataOffset length);
     void handleCompleteCallback(const QWeakPointer<Node>& node, MessageID messageID, AssetUtils::DataOffset length);
@@ -116,9 +150,17 @@ private:
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetAssetRequestData>> _pendingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetChunksCallback>> _pendingChunkListRequests;
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, FindChunksCallback>> _pendingFindChunksRequests;
 
     QString _cacheDir;
 
+    QHash<QByteArray, CachedChunk> _cachedChunks; // by chunk hash
+    bool _isChunkIndexLoaded { false };
+    bool _isChunkIndexLoading { false };
+    std::vector<std::pair<AssetUtils::AssetHash, std::vector<AssetUtils::AssetChunk>>> _pendingChunkIndexRecords;
+    std::vector<std::pair<std::vector<AssetUtils::AssetChunk>, LoadChunksCallback>> _pendingChunkLoads;
+
     friend class AssetRequest;
     friend class AssetUpload;
     friend class MappingRequest;
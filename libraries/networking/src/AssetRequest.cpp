@@ -25,6 +25,13 @@
 
 static int requestID = 0;
 
+// assets larger than this are fetched in parallel parts: the last PARALLEL_PART_SIZE bytes are asked for first, and
+// when they come back full the chunks of the asset are asked for. Whatever comes before the last part is taken from
+// the chunks other cached assets already hold, the rest is split between up to MAX_PARALLEL_PARTS more requests
+// for each run of missing chunks
+static const int64_t PARALLEL_PART_SIZE = 1024 * 1024;
+static const int64_t MAX_PARALLEL_PARTS = 4;
+
 AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     _requestID(++requestID),
     _hash(hash),
@@ -34,10 +41,7 @@ AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
 }
 
 AssetRequest::~AssetRequest() {
-    auto assetClient = DependencyManager::get<AssetClient>();
-    if (_assetRequestID) {
-        assetClient->cancelGetAssetRequest(_assetRequestID);
-    }
+    cancelPendingRequests();
 }
 
 void AssetRequest::start() {
@@ -75,64 +79,305 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        requestPart(_byteRange.fromInclusive, _byteRange.toExclusive);
+        return;
+    }
+
+    // a tail shorter than PARALLEL_PART_SIZE is the whole asset, so small assets still take a single request
+    requestPart(-PARALLEL_PART_SIZE, 0);
+}
+
+void AssetRequest::requestChunks() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    if (!assetClient->hasChunkCache()) {
+        // without a disk cache there is nowhere to find chunks in
+        requestAssetInfo();
+        return;
+    }
+
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    _assetChunksRequestID = assetClient->getAssetChunks(_hash,
+        [this, that](bool responseReceived, AssetUtils::AssetServerError serverError,
+                     const std::vector<AssetUtils::AssetChunk>& chunks) {
+
+        if (!that || _state == Finished) {
+            return;
+        }
+        _assetChunksRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived || serverError == AssetUtils::AssetServerError::AssetNotFound) {
+            finishWithError(responseReceived, serverError);
+            return;
+        } else if (serverError != AssetUtils::AssetServerError::NoError) {
+            // the asset server doesn't split its assets, fetch it in parts instead
+            requestAssetInfo();
+            return;
+        }
+
+        _chunks = chunks;
+        _assetSize = 0;
+        for (const auto& chunk : _chunks) {
+            _assetSize += chunk.length;
+        }
+        requestMissingChunks();
+    });
+}
+
+void AssetRequest::requestMissingChunks() {
+    int64_t headSize = std::max(_assetSize - PARALLEL_PART_SIZE, (int64_t)0);
+    if (headSize == 0) {
+        finishIfComplete();
+        return;
+    }
+
+    // the tail was already received, so the chunks are cut off where it starts
+    std::vector<AssetUtils::AssetChunk> headChunks;
+    for (const auto& chunk : _chunks) {
+        if (chunk.offset >= headSize) {
+            break;
+        }
+        headChunks.push_back(chunk);
+    }
+
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    _isLoadingCachedChunks = true;
+    DependencyManager::get<AssetClient>()->loadChunksFromCache(headChunks,
+        [this, that, headChunks, headSize](const std::map<AssetUtils::DataOffset, QByteArray>& cachedChunks) {
+
+        if (!that || _state == Finished) {
+            return;
+        }
+        _isLoadingCachedChunks = false;
+
+        int64_t missingFrom = -1;
+        for (const auto& chunk : headChunks) {
+            if (_state == Finished) {
+                break;
+            }
+
+            auto cachedChunk = cachedChunks.find(chunk.offset);
+            if (cachedChunk != cachedChunks.end()) {
+                if (missingFrom >= 0) {
+                    requestParts(missingFrom, chunk.offset);
+                    missingFrom = -1;
+                }
+                auto data = cachedChunk->second.left((int)(std::min(chunk.offset + chunk.length, headSize) - chunk.offset));
+                _totalReceived += data.size();
+                _receivedParts[chunk.offset] = data;
+            } else if (missingFrom < 0) {
+                missingFrom = chunk.offset;
+            }
+        }
+        if (missingFrom >= 0 && _state != Finished) {
+            requestParts(missingFrom, headSize);
+        }
+        if (_state != Finished) {
+            finishIfComplete();
+        }
+    });
+}
+
+void AssetRequest::requestAssetInfo() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    _assetInfoRequestID = assetClient->getAssetInfo(_hash,
+        [this, that](bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info) {
+
+        if (!that || _state == Finished) {
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError) {
+            finishWithError(responseReceived, serverError);
+            return;
+        }
+
+        _assetSize = info.size;
+        requestHead();
+        finishIfComplete();
+    });
+}
+
+void AssetRequest::requestPart(int64_t fromInclusive, int64_t toExclusive) {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
 
-    _assetRequestID = assetClient->getAsset(_hash, _byteRange.fromInclusive, _byteRange.toExclusive,
-        [this, that, hash](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+    auto partRequestID = assetClient->getAsset(_hash, fromInclusive, toExclusive,
+        [this, that, hash, fromInclusive](bool responseReceived, AssetUtils::AssetServerError serverError,
+                                          const QByteArray& data) {
 
         if (!that) {
             qCWarning(asset_client) << "Got reply for dead asset request " << hash << "- error code" << _error;
             // If the request is dead, return
             return;
         }
-        _assetRequestID = INVALID_MESSAGE_ID;
+        _pendingParts.erase(fromInclusive);
 
-        if (!responseReceived) {
-            _error = NetworkError;
-        } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
-        } else {
-            if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
-                // the hash of the received data does not match what we expect, so we return an error
-                _error = HashVerificationFailed;
-            }
+        if (_state == Finished) {
+            return;
+        }
 
-            if (_error == NoError) {
-                _data = data;
-                _totalReceived += data.size();
-                emit progress(_totalReceived, data.size());
+        if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError) {
+            finishWithError(responseReceived, serverError);
+            return;
+        }
 
-                if (!_byteRange.isSet()) {
-                    AssetUtils::saveToCache(getUrl(), data);
-                }
-            }
+        _totalReceived += data.size();
+
+        if (_byteRange.isSet()) {
+            _data = data;
+            emit progress(_totalReceived, data.size());
+
+            _state = Finished;
+            emit finished(this);
+            return;
         }
-        
-        if (_error != NoError) {
-            qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+
+        if (fromInclusive < 0) {
+            _tail = data;
+            _tailReceived = true;
+            if (data.size() < PARALLEL_PART_SIZE) {
+                _assetSize = data.size();
+            } else {
+                // only a full tail can have more of the asset in front of it
+                requestChunks();
+                return;
+            }
+        } else {
+            _receivedParts[fromInclusive] = data;
         }
-        
-        _state = Finished;
-        emit finished(this);
-    }, [this, that](qint64 totalReceived, qint64 total) {
+        finishIfComplete();
+    }, [this, that, fromInclusive](qint64 totalReceived, qint64 total) {
         if (!that) {
             // If the request is dead, return
             return;
         }
-        emit progress(totalReceived, total);
+
+        if (_byteRange.isSet()) {
+            emit progress(totalReceived, total);
+            return;
+        }
+
+        auto it = _pendingParts.find(fromInclusive);
+        if (it != _pendingParts.end()) {
+            it->second.bytesReceived = totalReceived;
+        }
+
+        qint64 received = _totalReceived;
+        for (const auto& part : _pendingParts) {
+            received += part.second.bytesReceived;
+        }
+        emit progress(received, _assetSize >= 0 ? _assetSize : std::max(total, received));
     });
+
+    // a request that could not be sent has already failed through its callback
+    if (partRequestID != INVALID_MESSAGE_ID) {
+        _pendingParts[fromInclusive] = { partRequestID, 0 };
+    }
+}
+
+void AssetRequest::requestHead() {
+    int64_t headSize = std::max(_assetSize - PARALLEL_PART_SIZE, (int64_t)0);
+    if (headSize > 0) {
+        requestParts(0, headSize);
+    }
+}
+
+void AssetRequest::requestParts(int64_t fromInclusive, int64_t toExclusive) {
+    int64_t size = toExclusive - fromInclusive;
+    int64_t numParts = std::min((size + PARALLEL_PART_SIZE - 1) / PARALLEL_PART_SIZE, MAX_PARALLEL_PARTS);
+    int64_t partSize = (size + numParts - 1) / numParts;
+    for (int64_t offset = fromInclusive; offset < toExclusive && _state != Finished; offset += partSize) {
+        requestPart(offset, std::min(offset + partSize, toExclusive));
+    }
+}
+
+void AssetRequest::finishIfComplete() {
+    if (_assetSize < 0 || !_tailReceived || !_pendingParts.empty() || _isLoadingCachedChunks) {
+        return;
+    }
+
+    QByteArray data;
+    data.reserve((int)_assetSize);
+    for (const auto& part : _receivedParts) {
+        data.append(part.second);
+    }
+    data.append(_tail);
+    _receivedParts.clear();
+    _tail.clear();
+
+    if (data.size() != _assetSize) {
+        _error = SizeVerificationFailed;
+    } else if (AssetUtils::hashData(data).toHex() != _hash) {
+        // the hash of the received data does not match what we expect, so we return an error
+        _error = HashVerificationFailed;
+    }
+
+    if (_error == NoError) {
+        _data = data;
+        emit progress(_totalReceived, data.size());
+
+        if (AssetUtils::saveToCache(getUrl(), data) && !_chunks.empty()) {
+            DependencyManager::get<AssetClient>()->addChunksToCacheIndex(_hash, _chunks);
+        }
+    } else {
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+    }
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::finishWithError(bool responseReceived, AssetUtils::AssetServerError serverError) {
+    if (!responseReceived) {
+        _error = NetworkError;
+    } else {
+        switch (serverError) {
+            case AssetUtils::AssetServerError::AssetNotFound:
+                _error = NotFound;
+                break;
+            case AssetUtils::AssetServerError::InvalidByteRange:
+                _error = InvalidByteRange;
+                break;
+            default:
+                _error = UnknownError;
+                break;
+        }
+    }
+
+    qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+
+    // the other parts are of no use now
+    cancelPendingRequests();
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::cancelPendingRequests() {
+    if (_assetInfoRequestID == INVALID_MESSAGE_ID && _assetChunksRequestID == INVALID_MESSAGE_ID && _pendingParts.empty()) {
+        return;
+    }
+
+    auto assetClient = DependencyManager::get<AssetClient>();
+    if (_assetInfoRequestID != INVALID_MESSAGE_ID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+    }
+    if (_assetChunksRequestID != INVALID_MESSAGE_ID) {
+        assetClient->cancelGetAssetChunksRequest(_assetChunksRequestID);
+        _assetChunksRequestID = INVALID_MESSAGE_ID;
+    }
+    for (const auto& part : _pendingParts) {
+        assetClient->cancelGetAssetRequest(part.second.requestID);
+    }
+    _pendingParts.clear();
 }
 
 
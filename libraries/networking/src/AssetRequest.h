@@ -12,6 +12,9 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <map>
+#include <vector>
+
 #include <QByteArray>
 #include <QObject>
 #include <QString>
@@ -62,6 +65,21 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    void requestPart(int64_t fromInclusive, int64_t toExclusive);
+    void requestParts(int64_t fromInclusive, int64_t toExclusive);
+    void requestChunks();
+    void requestMissingChunks();
+    void requestAssetInfo();
+    void requestHead();
+    void finishIfComplete();
+    void finishWithError(bool responseReceived, AssetUtils::AssetServerError serverError);
+    void cancelPendingRequests();
+
+    struct PendingPart {
+        MessageID requestID;
+        qint64 bytesReceived;
+    };
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -69,7 +87,15 @@ private:
     QString _hash;
     QByteArray _data;
     int _numPendingRequests { 0 };
-    MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
+    MessageID _assetChunksRequestID { INVALID_MESSAGE_ID };
+    std::vector<AssetUtils::AssetChunk> _chunks;
+    std::map<int64_t, PendingPart> _pendingParts; // by the start of their range
+    std::map<int64_t, QByteArray> _receivedParts; // by the start of their range
+    QByteArray _tail;
+    bool _tailReceived { false };
+    bool _isLoadingCachedChunks { false };
+    int64_t _assetSize { -1 };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
 };
@@ -11,6 +11,8 @@
 
 #include "AssetUpload.h"
 
+#include <algorithm>
+
 #include <QtCore/QFileInfo>
 #include <QtCore/QThread>
 
@@ -80,34 +82,71 @@ void AssetUpload::start() {
     if (!_filename.isEmpty()) {
         qCDebug(asset_client) << "Attempting to upload" << _filename << "to asset-server.";
     }
-    
-    assetClient->uploadAsset(_data, [this](bool responseReceived, AssetUtils::AssetServerError error, const QString& hash){
-        if (!responseReceived) {
-            _error = NetworkError;
-        } else {
-            switch (error) {
-                case AssetUtils::AssetServerError::NoError:
-                    _error = NoError;
-                    break;
-                case AssetUtils::AssetServerError::AssetTooLarge:
-                    _error = TooLarge;
-                    break;
-                case AssetUtils::AssetServerError::PermissionDenied:
-                    _error = PermissionDenied;
-                    break;
-                case AssetUtils::AssetServerError::FileOperationFailed:
-                    _error = ServerFileError;
-                    break;
-                default:
-                    _error = FileOpenError;
-                    break;
+
+    // an asset made of several chunks may share some of them with an asset the server holds, those are left out
+    if (_data.size() <= AssetUtils::MAX_CHUNK_SIZE) {
+        uploadData();
+        return;
+    }
+
+    _chunks = AssetUtils::chunkData(_data);
+    assetClient->findAssetChunks(_chunks, [this](bool responseReceived, AssetUtils::AssetServerError error,
+                                                 const std::vector<bool>& serverHasChunk) {
+        bool serverHasAnyChunk = std::find(serverHasChunk.begin(), serverHasChunk.end(), true) != serverHasChunk.end();
+        if (!responseReceived || error != AssetUtils::AssetServerError::NoError || !serverHasAnyChunk) {
+            uploadData();
+            return;
+        }
+
+        auto assetClient = DependencyManager::get<AssetClient>();
+        assetClient->uploadAssetChunks(_data, _chunks, serverHasChunk,
+            [this](bool responseReceived, AssetUtils::AssetServerError error, const QString& hash) {
+
+            if (responseReceived && error == AssetUtils::AssetServerError::AssetNotFound) {
+                // one of the chunks was deleted since the server was asked for them
+                uploadData();
+                return;
             }
+            handleUploadResult(responseReceived, error, hash);
+        });
+    });
+}
+
+void AssetUpload::uploadData() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    assetClient->uploadAsset(_data, [this](bool responseReceived, AssetUtils::AssetServerError error, const QString& hash) {
+        handleUploadResult(responseReceived, error, hash);
+    });
+}
+
+void AssetUpload::handleUploadResult(bool responseReceived, AssetUtils::AssetServerError error, const QString& hash) {
+    if (!responseReceived) {
+        _error = NetworkError;
+    } else {
+        switch (error) {
+            case AssetUtils::AssetServerError::NoError:
+                _error = NoError;
+                break;
+            case AssetUtils::AssetServerError::AssetTooLarge:
+                _error = TooLarge;
+                break;
+            case AssetUtils::AssetServerError::PermissionDenied:
+                _error = PermissionDenied;
+                break;
+            case AssetUtils::AssetServerError::FileOperationFailed:
+                _error = ServerFileError;
+                break;
+            default:
+                _error = FileOpenError;
+                break;
         }
-        
-        if (_error == NoError && hash == AssetUtils::hashData(_data).toHex()) {
-            AssetUtils::saveToCache(AssetUtils::getATPUrl(hash), _data);
+    }
+
+    if (_error == NoError && hash == AssetUtils::hashData(_data).toHex()) {
+        if (AssetUtils::saveToCache(AssetUtils::getATPUrl(hash), _data) && !_chunks.empty()) {
+            DependencyManager::get<AssetClient>()->addChunksToCacheIndex(hash, _chunks);
         }
-        
-        emit finished(this, hash);
-    });
+    }
+
+    emit finished(this, hash);
 }
@@ -17,6 +17,9 @@
 #include <QtCore/QObject>
 
 #include <cstdint>
+#include <vector>
+
+#include "AssetUtils.h"
 
 // You should be able to upload an asset from any thread, and handle the responses in a safe way
 // on your own thread. Everything should happen on AssetClient's thread, the caller should
@@ -52,8 +55,12 @@ signals:
     void progress(uint64_t totalReceived, uint64_t total);
     
 private:
+    void uploadData();
+    void handleUploadResult(bool responseReceived, AssetUtils::AssetServerError error, const QString& hash);
+
     QString _filename;
     QByteArray _data;
+    std::vector<AssetUtils::AssetChunk> _chunks;
     Error _error;
 };
 
@@ -11,6 +11,8 @@
 
 #include "AssetUtils.h"
 
+#include <algorithm>
+#include <array>
 #include <memory>
 
 #include <QtCore/QCryptographicHash>
@@ -62,6 +64,55 @@ QByteArray hashData(const QByteArray& data) {
     return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
 }
 
+// a boundary is expected every 64KB after the minimum chunk size, the top bits of the
+// gear hash depend on the last 64 bytes only
+static const uint64_t CHUNK_BOUNDARY_MASK = 0xFFFF000000000000ULL;
+
+static const std::array<uint64_t, 256>& gearTable() {
+    // the table has to be the same everywhere, so it comes from a fixed seed
+    static const std::array<uint64_t, 256> table = [] {
+        std::array<uint64_t, 256> gear;
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (auto& value : gear) {
+            // splitmix64
+            state += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            value = z ^ (z >> 31);
+        }
+        return gear;
+    }();
+    return table;
+}
+
+std::vector<AssetChunk> chunkData(const QByteArray& data) {
+    const auto& gear = gearTable();
+    auto bytes = reinterpret_cast<const uint8_t*>(data.constData());
+    int64_t size = data.size();
+
+    std::vector<AssetChunk> chunks;
+    int64_t start = 0;
+    while (start < size) {
+        int64_t end = std::min(start + MAX_CHUNK_SIZE, size);
+        int64_t position = start + MIN_CHUNK_SIZE;
+        uint64_t hash = 0;
+        for (; position < end; ++position) {
+            hash = (hash << 1) + gear[bytes[position]];
+            if ((hash & CHUNK_BOUNDARY_MASK) == 0) {
+                ++position;
+                break;
+            }
+        }
+        position = std::min(position, end);
+
+        int64_t length = position - start;
+        chunks.push_back({ start, length, hashData(QByteArray::fromRawData(data.constData() + start, length)) });
+        start = position;
+    }
+    return chunks;
+}
+
 QByteArray loadFromCache(const QUrl& url) {
     if (auto cache = NetworkAccessManager::getInstance().cache()) {
 
@@ -15,6 +15,7 @@
 #include <cstdint>
 
 #include <map>
+#include <vector>
 
 #include <QtCore/QByteArray>
 #include <QtCore/QUrl>
@@ -81,6 +82,21 @@ AssetHash extractAssetHash(const QString& input);
 
 QByteArray hashData(const QByteArray& data);
 
+// A piece of an asset whose boundaries are found from its contents, so that an edit to an asset only changes
+// the chunks around it, and the chunks of two versions of an asset can be told apart by their hashes.
+struct AssetChunk {
+    DataOffset offset;
+    int64_t length;
+    QByteArray hash;
+};
+
+const int64_t MIN_CHUNK_SIZE = 16 * 1024;
+const int64_t MAX_CHUNK_SIZE = 256 * 1024;
+
+// Splits data into content-defined chunks with a gear rolling hash, about 80KB each, and hashes every chunk.
+// Both ends of a transfer find the same chunks for the same data.
+std::vector<AssetChunk> chunkData(const QByteArray& data);
+
 QByteArray loadFromCache(const QUrl& url);
 bool saveToCache(const QUrl& url, const QByteArray& file);
 
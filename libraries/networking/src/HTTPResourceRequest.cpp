@@ -11,6 +11,10 @@
 
 #include "HTTPResourceRequest.h"
 
+#include <memory>
+
+#include <QAbstractNetworkCache>
+#include <QDateTime>
 #include <QFile>
 #include <QNetworkReply>
 #include <QNetworkRequest>
@@ -49,9 +53,91 @@ void HTTPResourceRequest::cleanupTimer() {
     _sendTimer = nullptr;
 }
 
+// the number of seconds a response may be used after it expired while it is revalidated, from the
+// stale-while-revalidate directive of its Cache-Control header (RFC 5861), 0 if it has none or must be revalidated first
+static qint64 getStaleWhileRevalidate(const QNetworkCacheMetaData& metaData) {
+    static const QByteArray CACHE_CONTROL_HEADER = "cache-control";
+    static const QByteArray STALE_WHILE_REVALIDATE_DIRECTIVE = "stale-while-revalidate=";
+
+    qint64 seconds = 0;
+    for (const auto& header : metaData.rawHeaders()) {
+        if (header.first.toLower() != CACHE_CONTROL_HEADER) {
+            continue;
+        }
+        for (const auto& directive : header.second.split(',')) {
+            auto trimmedDirective = directive.trimmed().toLower();
+            if (trimmedDirective == "must-revalidate" || trimmedDirective == "no-cache") {
+                return 0;
+            } else if (trimmedDirective.startsWith(STALE_WHILE_REVALIDATE_DIRECTIVE)) {
+                bool ok;
+                seconds = trimmedDirective.mid(STALE_WHILE_REVALIDATE_DIRECTIVE.size()).toLongLong(&ok);
+                if (!ok) {
+                    seconds = 0;
+                }
+            }
+        }
+    }
+    return seconds;
+}
+
+bool HTTPResourceRequest::loadStaleFromCache() {
+    auto& networkAccessManager = NetworkAccessManager::getInstance();
+    auto cache = networkAccessManager.cache();
+    if (!cache) {
+        return false;
+    }
+
+    // fresh responses are served by the network access manager itself, stale ones are only used within their window
+    auto metaData = cache->metaData(_url);
+    if (!metaData.isValid() || !metaData.saveToDisk() || !metaData.expirationDate().isValid()) {
+        return false;
+    }
+
+    // the disk cache also keeps redirects and errors such as 301 or 410, those are never served as resource data
+    const int HTTP_OK = 200;
+    if (metaData.attributes().value(QNetworkRequest::HttpStatusCodeAttribute).toInt() != HTTP_OK) {
+        return false;
+    }
+    auto secondsStale = metaData.expirationDate().secsTo(QDateTime::currentDateTimeUtc());
+    if (secondsStale <= 0 || secondsStale > getStaleWhileRevalidate(metaData)) {
+        return false;
+    }
+
+    // caller is responsible for the deletion of the ioDevice, hence the unique_ptr
+    auto ioDevice = std::unique_ptr<QIODevice>(cache->data(_url));
+    if (!ioDevice) {
+        return false;
+    }
+    _data = ioDevice->readAll();
+    _loadedFromCache = true;
+    _result = Success;
+
+    // a conditional request brings the cached response up to date for the next load, whatever its answer
+    QNetworkRequest networkRequest(_url);
+    networkRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    networkRequest.setHeader(QNetworkRequest::UserAgentHeader, HIGH_FIDELITY_USER_AGENT);
+    networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+    auto revalidateReply = networkAccessManager.get(networkRequest);
+    connect(revalidateReply, &QNetworkReply::finished, revalidateReply, &QObject::deleteLater);
+
+    qCDebug(networking) << "Serving stale" << _url.toDisplayString() << "from disk cache while revalidating it";
+
+    _state = Finished;
+    emit finished();
+
+    auto statTracker = DependencyManager::get<StatTracker>();
+    statTracker->incrementStat(STAT_HTTP_REQUEST_SUCCESS);
+    statTracker->incrementStat(STAT_HTTP_REQUEST_CACHE);
+    return true;
+}
+
 void HTTPResourceRequest::doSend() {
     DependencyManager::get<StatTracker>()->incrementStat(STAT_HTTP_REQUEST_STARTED);
 
+    if (_cacheEnabled && !_byteRange.isSet() && loadStaleFromCache()) {
+        return;
+    }
+
     QNetworkRequest networkRequest(_url);
     networkRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
     networkRequest.setHeader(QNetworkRequest::UserAgentHeader, HIGH_FIDELITY_USER_AGENT);
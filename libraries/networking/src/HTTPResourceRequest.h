@@ -41,6 +41,10 @@ private:
     void setupTimer();
     void cleanupTimer();
 
+    // serves a stale response from the disk cache while the cache revalidates it in the background,
+    // if its Cache-Control allows that
+    bool loadStaleFromCache();
+
     QTimer* _sendTimer { nullptr };
     QNetworkReply* _reply { nullptr };
 };
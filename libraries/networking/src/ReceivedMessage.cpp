@@ -12,6 +12,8 @@
 
 #include "ReceivedMessage.h"
 
+#include <algorithm>
+
 #include "QSharedPointer"
 
 int receivedMessageMetaTypeId = qRegisterMetaType<ReceivedMessage*>("ReceivedMessage*");
@@ -70,7 +72,10 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
+    {
+        std::lock_guard<std::mutex> lock(_dataMutex);
+        _data.append(packet.getPayload(), packet.getPayloadSize());
+    }
 
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
@@ -115,6 +120,19 @@ QByteArray ReceivedMessage::readHead(qint64 size) {
     return data;
 }
 
+QByteArray ReceivedMessage::takeReceived(qint64 size) {
+    std::lock_guard<std::mutex> lock(_dataMutex);
+    qint64 position = _position;
+    auto data = _data.mid((int)position, (int)std::min(size, _data.size() - position));
+
+    // a copy of what is left lets go of the whole buffer, removing from the front would keep its capacity
+    qint64 numBytesTaken = position + data.size();
+    _data = _data.mid((int)numBytesTaken);
+    _numBytesTaken += numBytesTaken;
+    _position = 0;
+    return data;
+}
+
 QByteArray ReceivedMessage::readAll() {
     return read(getBytesLeftToRead());
 }
@@ -16,6 +16,7 @@
 #include <QObject>
 
 #include <atomic>
+#include <mutex>
 
 #include "NLPacketList.h"
 
@@ -48,7 +49,7 @@ public:
     // Get the number of packets that were used to send this message
     qint64 getNumPackets() const { return _numPackets; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _numBytesTaken + _data.size(); }
 
     qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
 
@@ -69,6 +70,11 @@ public:
 
     QByteArray readHead(qint64 size);
 
+    // Takes up to size bytes of what has been received so far, and releases them and everything read before them.
+    // Unlike the readers above, this is safe to call while packets are still being appended on another thread, for
+    // listeners that have pending messages delivered. Once it is called the message can only be read with it.
+    QByteArray takeReceived(qint64 size);
+
     // This will return a QByteArray referencing the underlying data _without_ refcounting that data.
     // Be careful when using this method, only use it when the lifetime of the returned QByteArray will not
     // exceed that of the ReceivedMessage.
@@ -89,8 +95,10 @@ private slots:
 private:
     QByteArray _data;
     QByteArray _headData;
+    std::mutex _dataMutex; // guards appending to _data against takeReceived
 
     std::atomic<qint64> _position { 0 };
+    std::atomic<qint64> _numBytesTaken { 0 };
     std::atomic<qint64> _numPackets { 0 };
 
     NLPacket::LocalID _sourceID { NLPacket::NULL_LOCAL_ID };
@@ -371,7 +371,8 @@ public:
     /// Makes sure that the resource has started loading.
     void ensureLoading();
 
-    /// Sets the load priority for one owner.
+    /// Sets the load priority for one owner. Priorities order the requests that are waiting for a slot, a request that
+    /// is already loading keeps its slot whatever its priority becomes.
     virtual void setLoadPriority(const QPointer<QObject>& owner, float priority);
     
     /// Sets a set of priorities at once.
@@ -63,7 +63,10 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AssetGetInfo:
         case PacketType::AssetGet:
         case PacketType::AssetUpload:
-            return static_cast<PacketVersion>(AssetServerPacketVersion::BakingTextureMeta);
+        case PacketType::AssetGetChunks:
+        case PacketType::AssetFindChunks:
+        case PacketType::AssetUploadChunks:
+            return static_cast<PacketVersion>(AssetServerPacketVersion::ChunkedTransfers);
         case PacketType::NodeIgnoreRequest:
             return 18; // Introduction of node ignore request (which replaced an unused packet tpye)
 
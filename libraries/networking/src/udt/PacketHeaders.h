@@ -134,6 +134,11 @@ public:
         EntityClone,
         EntityQueryInitialResultsComplete,
         BulkAvatarTraits,
+        AssetGetChunks,
+        AssetGetChunksReply,
+        AssetFindChunks,
+        AssetFindChunksReply,
+        AssetUploadChunks,
 
         NUM_PACKET_TYPE
     };
@@ -193,7 +198,11 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_SOURCED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperation
             << PacketTypeEnum::Value::AssetGet
-            << PacketTypeEnum::Value::AssetUpload;
+            << PacketTypeEnum::Value::AssetGetInfo
+            << PacketTypeEnum::Value::AssetGetChunks
+            << PacketTypeEnum::Value::AssetUpload
+            << PacketTypeEnum::Value::AssetFindChunks
+            << PacketTypeEnum::Value::AssetUploadChunks;
         return DOMAIN_SOURCED_PACKETS;
     }
 
@@ -201,7 +210,10 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_IGNORED_VERIFICATION_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperationReply
             << PacketTypeEnum::Value::AssetGetReply
-            << PacketTypeEnum::Value::AssetUploadReply;
+            << PacketTypeEnum::Value::AssetGetInfoReply
+            << PacketTypeEnum::Value::AssetGetChunksReply
+            << PacketTypeEnum::Value::AssetUploadReply
+            << PacketTypeEnum::Value::AssetFindChunksReply;
         return DOMAIN_IGNORED_VERIFICATION_PACKETS;
     }
 };
@@ -266,7 +278,8 @@ enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    ChunkedTransfers
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
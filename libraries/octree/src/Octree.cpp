@@ -84,6 +84,10 @@ void Octree::recurseElementWithOperation(const OctreeElementPointer& element, co
 
     if (operation(element, extraData)) {
         for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            if (!element->hasChildAtIndex(i)) {
+                continue;
+            }
+            // a copy, since the operation is free to change the children of the elements it visits
             OctreeElementPointer child = element->getChildAtIndex(i);
             if (child) {
                 recurseElementWithOperation(child, operation, extraData, recursionCount + 1);
@@ -108,15 +112,12 @@ bool Octree::recurseElementWithOperationSorted(const OctreeElementPointer& eleme
     bool keepSearching = operation(element, extraData);
 
     std::vector<SortedChild> sortedChildren;
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        OctreeElementPointer child = element->getChildAtIndex(i);
-        if (child) {
-            float priority = sortingOperation(child, extraData);
-            if (priority < FLT_MAX) {
-                sortedChildren.emplace_back(priority, child);
-            }
+    element->forEachChild([&](int childIndex, const OctreeElementPointer& child) {
+        float priority = sortingOperation(child, extraData);
+        if (priority < FLT_MAX) {
+            sortedChildren.emplace_back(priority, child);
         }
-    }
+    });
 
     if (sortedChildren.size() > 1) {
         static auto comparator = [](const SortedChild& left, const SortedChild& right) { return left.first < right.first; };
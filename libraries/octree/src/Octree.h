@@ -12,18 +12,22 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <stdint.h>
+#include <vector>
 
 #include <QHash>
 #include <QObject>
+#include <QSharedPointer>
 #include <QtCore/QJsonObject>
 
 #include <shared/ReadWriteLockable.h>
 #include <SimpleMovingAverage.h>
 #include <ViewFrustum.h>
 
+#include "OctreeDataUtils.h"
 #include "OctreeElement.h"
 #include "OctreeElementBag.h"
 #include "OctreePacketData.h"
@@ -138,6 +142,28 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+    // Called with only the read lock held. Trees that can apply an edit without changing their structure
+    // do so here and return true, otherwise the edit goes through processEditPacketData under the write lock.
+    virtual bool processInPlaceEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                              const SharedNodePointer& sourceNode, int& bytesRead) { return false; }
+
+    // An edit that a tree held back in holdEditPacketData, to be applied once it is released.
+    struct HeldEdit {
+        QSharedPointer<ReceivedMessage> message;
+        int offset;
+        int length;
+        SharedNodePointer sourceNode;
+    };
+    // Called with only the read lock held, for every edit before it is applied. Trees that coalesce edits return true
+    // if they held this one back, it is then dropped if a later edit supersedes it. Edits that have to be applied before
+    // this one are added to readyEdits, in order.
+    virtual bool holdEditPacketData(const QSharedPointer<ReceivedMessage>& message, const unsigned char* editData,
+                                    int maxLength, const SharedNodePointer& sourceNode, int& bytesRead,
+                                    std::vector<HeldEdit>& readyEdits) { return false; }
+    // Adds the held edits whose window has passed, or all of them, to readyEdits in the order they arrived.
+    virtual void releaseHeldEdits(bool releaseAll, std::vector<HeldEdit>& readyEdits) { }
+    // When the next held edit is due, 0 if there are none.
+    virtual uint64_t getNextHeldEditRelease() const { return 0; }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -217,6 +243,12 @@ public:
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
 
+    // Binary journal a tree can persist to incrementally, next to the JSON file. When there is one it is more
+    // recent than the JSON file, and its info has the persist ID and versions of its last commit.
+    virtual bool readPersistJournalInfo(const QString& filename, OctreeUtils::RawOctreeData& data) const { return false; }
+    virtual bool readFromPersistJournal(const QString& filename) { return false; }
+    virtual bool writeToPersistJournal(const QString& filename) { return false; }
+
     uint64_t getOctreeElementsCount();
 
     bool getShouldReaverage() const { return _shouldReaverage; }
@@ -244,6 +276,8 @@ public:
         _persistID = id;
         _persistDataVersion = dataVersion;
     }
+    QUuid getPersistID() const { return _persistID; }
+    int64_t getPersistDataVersion() const { return _persistDataVersion; }
 
     virtual void resetEditStats() { }
     virtual quint64 getAverageDecodeTime() const { return 0; }
@@ -252,6 +286,7 @@ public:
     virtual quint64 getAverageCreateTime() const { return 0;  }
     virtual quint64 getAverageLoggingTime() const { return 0;  }
     virtual quint64 getAverageFilterTime() const { return 0; }
+    virtual quint64 getTotalCoalescedEdits() const { return 0; }
 
     void incrementPersistDataVersion() { _persistDataVersion++; }
 
@@ -271,7 +306,7 @@ protected:
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
 
-    bool _isDirty;
+    std::atomic<bool> _isDirty; // in place entity edits set it under the read lock
     bool _shouldReaverage;
 
     bool _isViewing;
@@ -71,28 +71,12 @@ void OctreeElement::init(unsigned char * octalCode) {
         delete[] octalCode;
     }
 
-    // set up the _children union
+    // all elements start as leaves, without a child array
     _childBitmask = 0;
-    _childrenExternal = false;
-
+    _children.reset();
 
     _childrenCount[0]++;
 
-    // default pointers to child nodes to NULL
-#ifdef SIMPLE_CHILD_ARRAY
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        _simpleChildArray[i] = NULL;
-    }
-#endif
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-    _childrenSingle.reset();
-#endif
-
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-        _externalChildren[i].reset();
-    }
-
     _isDirty = true;
     _shouldRender = false;
     _sourceUUIDKey = 0;
@@ -254,129 +238,77 @@ AtomicUIntStat OctreeElement::_externalChildrenCount { 0 };
 AtomicUIntStat OctreeElement::_childrenCount[NUMBER_OF_CHILDREN + 1];
 
 OctreeElementPointer OctreeElement::getChildAtIndex(int childIndex) const {
-#ifdef SIMPLE_CHILD_ARRAY
-    return _simpleChildArray[childIndex];
-#endif // SIMPLE_CHILD_ARRAY
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-    int childCount = getChildCount();
-
-    switch (childCount) {
-        case 0: {
-            return NULL;
-        } break;
-
-        case 1: {
-            // if our single child is the one being requested, return it, otherwise
-            // return null
-            int firstIndex = getNthBit(_childBitmask, 1);
-            if (firstIndex == childIndex) {
-                return _childrenSingle;
-            } else {
-                return NULL;
-            }
-        } break;
-
-        default : {
-            return _externalChildren[childIndex];
-        } break;
+    if (!hasChildAtIndex(childIndex)) {
+        return OctreeElementPointer();
     }
-#endif // def SIMPLE_EXTERNAL_CHILDREN
+    return _children[childSlot(childIndex)];
 }
 
 void OctreeElement::deleteAllChildren() {
-    // first delete all the OctreeElement objects...
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        OctreeElementPointer childAt = getChildAtIndex(i);
-        if (childAt) {
-            childAt.reset();
-        }
-    }
-
-    if (_childrenExternal) {
-        // if the children_t union represents _children.external we need to delete it here
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
+    // releasing the child array deletes the children we hold the last reference to
+    int childCount = getChildCount();
+    if (childCount > 0) {
+        _externalChildrenMemoryUsage -= childCount * sizeof(OctreeElementPointer);
+        _externalChildrenCount--;
     }
+    _childrenCount[childCount]--;
+    _childBitmask = 0;
+    _children.reset();
 }
 
 void OctreeElement::setChildAtIndex(int childIndex, const OctreeElementPointer& child) {
-#ifdef SIMPLE_CHILD_ARRAY
-    int previousChildCount = getChildCount();
-    if (child) {
-        setAtBit(_childBitmask, childIndex);
-    } else {
-        clearAtBit(_childBitmask, childIndex);
-    }
-    int newChildCount = getChildCount();
-
-    // store the child in our child array
-    _simpleChildArray[childIndex] = child;
+    bool hadChild = hasChildAtIndex(childIndex);
+    int slot = childSlot(childIndex);
 
-    // track our population data
-    if (previousChildCount != newChildCount) {
-        _childrenCount[previousChildCount]--;
-        _childrenCount[newChildCount]++;
+    if (hadChild && child) {
+        _children[slot] = child;
+        return;
+    } else if (!hadChild && !child) {
+        return;
     }
-#endif
 
-#ifdef SIMPLE_EXTERNAL_CHILDREN
+    // the child array always holds exactly the existing children, so adding or removing one replaces it
+    int previousChildCount = getChildCount();
+    int newChildCount = child ? previousChildCount + 1 : previousChildCount - 1;
 
-    int firstIndex = getNthBit(_childBitmask, 1);
-    int secondIndex = getNthBit(_childBitmask, 2);
+    std::unique_ptr<OctreeElementPointer[]> children;
+    if (newChildCount > 0) {
+        children.reset(new OctreeElementPointer[newChildCount]);
+        for (int i = 0; i < slot; i++) {
+            children[i] = std::move(_children[i]);
+        }
+        if (child) {
+            children[slot] = child;
+            for (int i = slot; i < previousChildCount; i++) {
+                children[i + 1] = std::move(_children[i]);
+            }
+        } else {
+            for (int i = slot + 1; i < previousChildCount; i++) {
+                children[i - 1] = std::move(_children[i]);
+            }
+        }
+    }
 
-    int previousChildCount = getChildCount();
     if (child) {
         setAtBit(_childBitmask, childIndex);
     } else {
         clearAtBit(_childBitmask, childIndex);
     }
-    int newChildCount = getChildCount();
+    _children = std::move(children);
 
     // track our population data
-    if (previousChildCount != newChildCount) {
-        _childrenCount[previousChildCount]--;
-        _childrenCount[newChildCount]++;
-    }
-
-    if ((previousChildCount == 0 || previousChildCount == 1) && newChildCount == 0) {
-        _childrenSingle.reset();
-    } else if (previousChildCount == 0 && newChildCount == 1) {
-        _childrenSingle = child;
-    } else if (previousChildCount == 1 && newChildCount == 2) {
-        OctreeElementPointer previousChild = _childrenSingle;
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
-        _externalChildren[firstIndex] = previousChild;
-        _externalChildren[childIndex] = child;
-
-        _childrenExternal = true;
-
-        _externalChildrenMemoryUsage += NUMBER_OF_CHILDREN * sizeof(OctreeElementPointer);
-
-    } else if (previousChildCount == 2 && newChildCount == 1) {
-        assert(!child); // we are removing a child, so this must be true!
-        OctreeElementPointer previousFirstChild = _externalChildren[firstIndex];
-        OctreeElementPointer previousSecondChild = _externalChildren[secondIndex];
-
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
-        _childrenExternal = false;
-
-        _externalChildrenMemoryUsage -= NUMBER_OF_CHILDREN * sizeof(OctreeElementPointer);
-        if (childIndex == firstIndex) {
-            _childrenSingle = previousSecondChild;
-        } else {
-            _childrenSingle = previousFirstChild;
-        }
+    _childrenCount[previousChildCount]--;
+    _childrenCount[newChildCount]++;
+    if (child) {
+        _externalChildrenMemoryUsage += sizeof(OctreeElementPointer);
     } else {
-        _externalChildren[childIndex] = child;
+        _externalChildrenMemoryUsage -= sizeof(OctreeElementPointer);
+    }
+    if (previousChildCount == 0) {
+        _externalChildrenCount++;
+    } else if (newChildCount == 0) {
+        _externalChildrenCount--;
     }
-
-#endif // def SIMPLE_EXTERNAL_CHILDREN
 }
 
 
@@ -12,10 +12,8 @@
 #ifndef hifi_OctreeElement_h
 #define hifi_OctreeElement_h
 
-//#define SIMPLE_CHILD_ARRAY
-#define SIMPLE_EXTERNAL_CHILDREN
-
 #include <atomic>
+#include <memory>
 
 #include <QReadWriteLock>
 
@@ -110,6 +108,7 @@ public:
     // Base class methods you don't need to implement
     const unsigned char* getOctalCode() const { return (_octcodePointer) ? _octalCode.pointer : &_octalCode.buffer[0]; }
     OctreeElementPointer getChildAtIndex(int childIndex) const;
+    bool hasChildAtIndex(int childIndex) const { return (_childBitmask >> (7 - childIndex)) & 1; }
     void deleteChildAtIndex(int childIndex);
     OctreeElementPointer removeChildAtIndex(int childIndex);
     bool isParentOf(const OctreeElementPointer& possibleChild) const;
@@ -135,6 +134,10 @@ public:
 
     bool isLeaf() const { return _childBitmask == 0; }
     int getChildCount() const { return numberOfOnes(_childBitmask); }
+
+    /// Calls f(childIndex, child) for each existing child, in child index order, without copying child pointers.
+    template <typename F>
+    void forEachChild(F f) const;
     void printDebugDetails(const char* label) const;
     bool isDirty() const { return _isDirty; }
     void clearDirtyBit() { _isDirty = false; }
@@ -214,6 +217,9 @@ protected:
     void deleteAllChildren();
     void setChildAtIndex(int childIndex, const OctreeElementPointer& child);
 
+    // where the child at childIndex is, or would go, in _children
+    int childSlot(int childIndex) const { return numberOfOnes(_childBitmask & ~(0xff >> childIndex)); }
+
     void calculateAACube();
 
     AACube _cube; /// Client and server, axis aligned box for bounds of this voxel, 48 bytes
@@ -224,20 +230,14 @@ protected:
       unsigned char* pointer;
     } _octalCode;
 
-    quint64 _lastChanged; /// Client and server, timestamp this node was last changed, 8 bytes
-    uint64_t _lastChangedContent { 0 };
+    // atomic because in place entity edits mark elements while send threads are reading them
+    std::atomic<quint64> _lastChanged { 0 }; /// Client and server, timestamp this node was last changed, 8 bytes
+    std::atomic<uint64_t> _lastChangedContent { 0 };
 
-    /// Client and server, pointers to child nodes, various encodings
-#ifdef SIMPLE_CHILD_ARRAY
-    OctreeElementPointer _simpleChildArray[8]; /// Only used when SIMPLE_CHILD_ARRAY is enabled
-#endif
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-    // union children_t {
-    OctreeElementPointer _childrenSingle;
-    OctreeElementPointer _externalChildren[NUMBER_OF_CHILDREN];
-    // } _children;
-#endif
+    /// Client and server, the existing children in child index order, 8 bytes
+    ///   A leaf holds no array and any other element holds exactly getChildCount() pointers, so the children of an
+    ///   element are contiguous, and ordered by octant, whichever of them exist.
+    std::unique_ptr<OctreeElementPointer[]> _children;
 
     uint16_t _sourceUUIDKey; /// Client only, stores node id of voxel server that sent his voxel, 2 bytes
 
@@ -254,8 +254,7 @@ protected:
          _isDirty : 1, /// Client only, has this voxel changed since being rendered, 1 bit
          _shouldRender : 1, /// Client only, should this voxel render at this time, 1 bit
          _octcodePointer : 1, /// Client and Server only, is this voxel's octal code a pointer or buffer, 1 bit
-         _unknownBufferIndex : 1,
-         _childrenExternal : 1; /// Client only, is this voxel's VBO buffer the unknown buffer index, 1 bit
+         _unknownBufferIndex : 1; /// Client only, is this voxel's VBO buffer the unknown buffer index, 1 bit
 
     static AtomicUIntStat _voxelNodeCount;
     static AtomicUIntStat _voxelNodeLeafCount;
@@ -273,4 +272,14 @@ protected:
     static AtomicUIntStat _childrenCount[NUMBER_OF_CHILDREN + 1];
 };
 
+template <typename F>
+void OctreeElement::forEachChild(F f) const {
+    int slot = 0;
+    for (int childIndex = 0; childIndex < NUMBER_OF_CHILDREN; ++childIndex) {
+        if (hasChildAtIndex(childIndex)) {
+            f(childIndex, _children[slot++]);
+        }
+    }
+}
+
 #endif // hifi_OctreeElement_h
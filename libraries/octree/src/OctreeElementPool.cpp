@@ -0,0 +1,84 @@
+//
+//  OctreeElementPool.cpp
+//  libraries/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeElementPool.h"
+
+#include <algorithm>
+#include <new>
+
+const size_t OctreeElementPool::DEFAULT_BLOCKS_PER_SLAB = 1024;
+
+// slabs come from new[], which is aligned for any type, so keeping block sizes a multiple of that keeps every block aligned
+static size_t alignedBlockSize(size_t blockSize) {
+    const size_t ALIGNMENT = alignof(std::max_align_t);
+    blockSize = std::max(blockSize, sizeof(void*));
+    return (blockSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+OctreeElementPool::OctreeElementPool(size_t blockSize, size_t blocksPerSlab) :
+    _blockSize(alignedBlockSize(blockSize)),
+    _blocksPerSlab(std::max(blocksPerSlab, (size_t)1))
+{
+}
+
+void OctreeElementPool::addSlab() {
+    std::unique_ptr<char[]> slab(new char[_blockSize * _blocksPerSlab]);
+
+    // thread the new blocks onto the free list in address order, so consecutive allocations are adjacent
+    char* blocks = slab.get();
+    for (size_t i = _blocksPerSlab; i > 0; --i) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(blocks + (i - 1) * _blockSize);
+        block->next = _freeList;
+        _freeList = block;
+    }
+    _slabs.push_back(std::move(slab));
+}
+
+void* OctreeElementPool::allocate(size_t size) {
+    if (size > _blockSize) {
+        return ::operator new(size);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_freeList) {
+        addSlab();
+    }
+    FreeBlock* block = _freeList;
+    _freeList = block->next;
+    ++_numAllocated;
+    return block;
+}
+
+void OctreeElementPool::deallocate(void* block, size_t size) {
+    if (!block) {
+        return;
+    }
+    if (size > _blockSize) {
+        ::operator delete(block);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = _freeList;
+    _freeList = freeBlock;
+    --_numAllocated;
+}
+
+size_t OctreeElementPool::getNumSlabs() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _slabs.size();
+}
+
+size_t OctreeElementPool::getNumAllocated() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numAllocated;
+}
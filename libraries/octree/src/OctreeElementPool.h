@@ -0,0 +1,55 @@
+//
+//  OctreeElementPool.h
+//  libraries/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeElementPool_h
+#define hifi_OctreeElementPool_h
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Fixed size block allocator for octree elements
+//   Blocks are carved out of large slabs, so elements created together (a load, or the children of an element)
+//   sit next to each other in memory instead of being scattered over the heap, and a traversal walks a few slabs
+//   rather than chasing pointers across it. Freed blocks go back on a free list for the next element and the slabs
+//   are kept for the life of the process. Element classes route their operator new and delete through a pool.
+class OctreeElementPool {
+public:
+    static const size_t DEFAULT_BLOCKS_PER_SLAB;
+
+    OctreeElementPool(size_t blockSize, size_t blocksPerSlab = DEFAULT_BLOCKS_PER_SLAB);
+
+    // sizes larger than the block size, from classes derived from the pooled one, go to the heap
+    void* allocate(size_t size);
+    void deallocate(void* block, size_t size);
+
+    size_t getBlockSize() const { return _blockSize; }
+    size_t getNumSlabs() const;
+    size_t getNumAllocated() const;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void addSlab();
+
+    const size_t _blockSize;
+    const size_t _blocksPerSlab;
+
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<char[]>> _slabs;
+    FreeBlock* _freeList { nullptr };
+    size_t _numAllocated { 0 };
+};
+
+#endif // hifi_OctreeElementPool_h
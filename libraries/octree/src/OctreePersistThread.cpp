@@ -27,6 +27,7 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QRegExp>
+#include <QSaveFile>
 
 #include <NumericalConstants.h>
 #include <PerfStat.h>
@@ -39,6 +40,10 @@
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 
+// when the tree has a persist journal every persist goes to it, and the JSON file and domain server copy are only
+// brought up to date every this many persist intervals and when the server stops
+constexpr int PERSIST_INTERVALS_PER_JSON_PERSIST { 10 };
+
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
@@ -48,6 +53,7 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _filename(filename),
     _persistInterval(persistInterval),
     _lastPersistCheck(std::chrono::steady_clock::now()),
+    _lastJSONPersist(_lastPersistCheck),
     _initialLoadComplete(false),
     _loadTimeUSecs(0),
     _debugTimestampNow(debugTimestampNow),
@@ -57,6 +63,7 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+    _journalFilename = sansExt + ".journal";
 }
 
 void OctreePersistThread::start() {
@@ -70,9 +77,10 @@ void OctreePersistThread::start() {
 
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
+    // the journal is ahead of the JSON file when there is one, and its header doesn't need the whole file parsed
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree) << "Reading octree data from" << _filename;
-    if (data.readOctreeDataInfoFromFile(_filename)) {
+    qCDebug(octree) << "Reading octree data from" << _journalFilename << "or" << _filename;
+    if (_tree->readPersistJournalInfo(_journalFilename, data) || data.readOctreeDataInfoFromFile(_filename)) {
         qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.version << ")";
         packet->writePrimitive(true);
         auto id = data.id.toRfc4122();
@@ -98,11 +106,21 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     QByteArray replacementData;
     OctreeUtils::RawOctreeData data;
     bool hasValidOctreeData { false };
+
+    bool hasPersistJournal { false };
+
     if (includesNewData) {
         replacementData = message->readAll();
         replaceData(replacementData);
+
+        // the journal has the data that was just replaced
+        QFile::remove(_journalFilename);
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
+    } else if (_tree->readPersistJournalInfo(_journalFilename, data)) {
+        qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
+        hasValidOctreeData = true;
+        hasPersistJournal = true;
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
         
@@ -139,7 +157,10 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
 
-        persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
+        persistentFileRead = hasPersistJournal && _tree->readFromPersistJournal(_journalFilename);
+        if (!persistentFileRead) {
+            persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
+        }
         _tree->pruneTree();
     });
 
@@ -171,6 +192,10 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
+    _lastJSONPersist = _lastPersistCheck;
+
+    // a journal is ahead of the JSON file, which catches up at the next JSON persist
+    _hasJSONPersistPending = persistentFileRead && hasPersistJournal;
 
     if (replacementData.isNull()) {
         sendLatestEntityDataToDS();
@@ -230,7 +255,7 @@ void OctreePersistThread::process() {
 
     if (timeSinceLastPersist > _persistInterval) {
         _lastPersistCheck = now;
-        persist();
+        persist(now - _lastJSONPersist > _persistInterval * PERSIST_INTERVALS_PER_JSON_PERSIST);
     }
 
     QTimer::singleShot(TIME_BETWEEN_PROCESSING.count(), this, &OctreePersistThread::process);
@@ -238,7 +263,7 @@ void OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
-    persist();
+    persist(true);
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
@@ -281,9 +306,13 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
     qDebug() << "Found" << count << "backups";
 }
 
-void OctreePersistThread::persist() {
-    if (_tree->isDirty() && _initialLoadComplete) {
+void OctreePersistThread::persist(bool persistJSON) {
+    if (!_initialLoadComplete) {
+        return;
+    }
 
+    bool journaled = true;
+    if (_tree->isDirty()) {
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
             _tree->pruneTree();
@@ -292,29 +321,86 @@ void OctreePersistThread::persist() {
 
         _tree->incrementPersistDataVersion();
 
-        qCDebug(octree) << "Saving Octree data to:" << _filename;
-        if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
+        if (_tree->writeToPersistJournal(_journalFilename)) {
             _tree->clearDirtyBit(); // tree is clean after saving
+            _hasJSONPersistPending = true;
+            qCDebug(octree) << "DONE persisting Octree data to" << _journalFilename;
+        } else {
+            // a journal that is behind must not be loaded in place of the JSON file written now
+            if (QFile::exists(_journalFilename) && !QFile::remove(_journalFilename)) {
+                qCWarning(octree) << "Failed to remove stale persist journal" << _journalFilename;
+            }
+            journaled = false;
+            persistJSON = true;
+            _hasJSONPersistPending = true;
+        }
+    }
+
+    if (persistJSON && _hasJSONPersistPending) {
+        _lastJSONPersist = std::chrono::steady_clock::now();
+
+        // the domain server gets the same gzipped JSON, so only encode it once when that is also our file type
+        QByteArray data;
+        bool encoded = _tree->toJSON(&data, nullptr, true);
+
+        qCDebug(octree) << "Saving Octree data to:" << _filename;
+        bool persisted;
+        if (_persistAsFileType == "json.gz") {
+            persisted = encoded && writePersistFile(data);
+        } else {
+            persisted = _tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType);
+        }
+
+        if (persisted) {
+            if (!journaled) {
+                _tree->clearDirtyBit(); // tree is clean after saving
+            }
+            _hasJSONPersistPending = false;
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
         }
 
-        sendLatestEntityDataToDS();
+        if (encoded) {
+            sendEntityDataToDS(data);
+        } else {
+            qCWarning(octree) << "Failed to persist octree to DS";
+        }
     }
 }
 
-void OctreePersistThread::sendLatestEntityDataToDS() {
-    qDebug() << "Sending latest entity data to DS";
-    auto nodeList = DependencyManager::get<NodeList>();
-    const DomainHandler& domainHandler = nodeList->getDomainHandler();
+bool OctreePersistThread::writePersistFile(const QByteArray& data) {
+    QSaveFile persistFile(_filename);
+    if (!persistFile.open(QIODevice::WriteOnly)) {
+        qCWarning(octree) << "Failed to open" << _filename << "for writing";
+        return false;
+    }
+    if (persistFile.write(data) == -1) {
+        qCWarning(octree) << "Failed to write to" << _filename;
+        return false;
+    }
+    if (!persistFile.commit()) {
+        qCWarning(octree) << "Failed to commit" << _filename << "-" << persistFile.errorString();
+        return false;
+    }
+    return true;
+}
 
+void OctreePersistThread::sendLatestEntityDataToDS() {
     QByteArray data;
     if (_tree->toJSON(&data, nullptr, true)) {
-        auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
-        message->write(data);
-        nodeList->sendPacketList(std::move(message), domainHandler.getSockAddr());
+        sendEntityDataToDS(data);
     } else {
         qCWarning(octree) << "Failed to persist octree to DS";
     }
 }
+
+void OctreePersistThread::sendEntityDataToDS(const QByteArray& data) {
+    qDebug() << "Sending latest entity data to DS";
+    auto nodeList = DependencyManager::get<NodeList>();
+    const DomainHandler& domainHandler = nodeList->getDomainHandler();
+
+    auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
+    message->write(data);
+    nodeList->sendPacketList(std::move(message), domainHandler.getSockAddr());
+}
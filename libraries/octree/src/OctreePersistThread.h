@@ -58,18 +58,23 @@ protected slots:
     void handleOctreeDataFileReply(QSharedPointer<ReceivedMessage> message);
 
 protected:
-    void persist();
+    void persist(bool persistJSON = false);
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
     void replaceData(QByteArray data);
+    bool writePersistFile(const QByteArray& data);
     void sendLatestEntityDataToDS();
+    void sendEntityDataToDS(const QByteArray& data);
 
 private:
     OctreePointer _tree;
     QString _filename;
+    QString _journalFilename;
     std::chrono::milliseconds _persistInterval;
     std::chrono::steady_clock::time_point _lastPersistCheck;
+    std::chrono::steady_clock::time_point _lastJSONPersist;
+    bool _hasJSONPersistPending { false }; // the journal has data the JSON file and domain server don't
     bool _initialLoadComplete;
 
     quint64 _loadTimeUSecs;
@@ -1223,6 +1223,16 @@ void Model::setURL(const QUrl& url) {
     onInvalidate();
 }
 
+void Model::setLoadingPriority(float priority) {
+    _loadingPriority = priority;
+    // a model that is still loading keeps its place in the request queue in step with its priority, and so do
+    // its textures
+    _renderWatcher.setLoadPriority(this, priority);
+    if (_renderGeometry) {
+        _renderGeometry->setTextureLoadPriority(this, priority);
+    }
+}
+
 void Model::loadURLFinished(bool success) {
     if (!success) {
         _visualGeometryRequestFailed = true;
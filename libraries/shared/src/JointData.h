@@ -2,6 +2,10 @@
 #ifndef hifi_JointData_h
 #define hifi_JointData_h
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
@@ -28,4 +32,32 @@ public:
     bool translationIsDefaultPose = true;
 };
 
+// Structure-of-arrays copy of a set of JointData, tagged with the version of the joints it was taken from.
+// A published snapshot is never modified, so readers can keep one without holding the owner's joint lock.
+class JointDataSnapshot {
+public:
+    int size() const { return (int)rotations.size(); }
+
+    void resize(int numJoints) {
+        rotations.resize(numJoints);
+        translations.resize(numJoints);
+        rotationIsDefaultPose.resize(numJoints);
+        translationIsDefaultPose.resize(numJoints);
+    }
+
+    void set(int index, const JointData& data) {
+        rotations[index] = data.rotation;
+        translations[index] = data.translation;
+        rotationIsDefaultPose[index] = data.rotationIsDefaultPose;
+        translationIsDefaultPose[index] = data.translationIsDefaultPose;
+    }
+
+    uint32_t version { 0 };
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> translations;
+    std::vector<uint8_t> rotationIsDefaultPose;
+    std::vector<uint8_t> translationIsDefaultPose;
+};
+using JointDataSnapshotPointer = std::shared_ptr<const JointDataSnapshot>;
+
 #endif
@@ -18,8 +18,10 @@
 
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
 #include <QtCore/QSaveFile>
 #include <QtCore/QStorageInfo>
+#include <QtCore/QTextStream>
 
 #include "../PathUtils.h"
 #include "../NumericalConstants.h"
@@ -40,6 +42,10 @@ using namespace cache;
 static const char DIR_SEP = '/';
 static const char EXT_SEP = '.';
 
+// lists the persisted files with their length and last use, so restoring them doesn't have to stat every one
+static const char* INDEX_FILENAME = "index";
+static const int INDEX_VERSION = 1;
+
 const size_t FileCache::DEFAULT_MAX_SIZE { GB_TO_BYTES(5) };
 const size_t FileCache::MAX_MAX_SIZE { GB_TO_BYTES(100) };
 const size_t FileCache::DEFAULT_MIN_FREE_STORAGE_SPACE { GB_TO_BYTES(1) };
@@ -65,13 +71,13 @@ std::string getCachePath(const std::string& dirname_str) {
 
 void FileCache::setMinFreeSize(size_t size) {
     _minFreeSpaceSize = size;
-    clean();
+    requestClean();
     emit dirty();
 }
 
 void FileCache::setMaxSize(size_t maxSize) {
     _maxSize = std::min(maxSize, MAX_MAX_SIZE);
-    clean();
+    requestClean();
     emit dirty();
 }
 
@@ -83,6 +89,7 @@ FileCache::FileCache(const std::string& dirname, const std::string& ext, QObject
 }
 
 FileCache::~FileCache() {
+    stopCleaning();
     clear();
 }
 
@@ -98,37 +105,108 @@ void FileCache::initialize() {
     if (dir.exists()) {
         auto nameFilters = QStringList(("*." + _ext).c_str());
         auto filters = QDir::Filters(QDir::NoDotAndDotDot | QDir::Files);
-        auto sort = QDir::SortFlags(QDir::Time);
-        auto files = dir.entryList(nameFilters, filters, sort);
-
-        // load persisted files
-        foreach(QString filename, files) {
-            const Key key = filename.section('.', 0, 0).toStdString();
-            const std::string filepath = dir.filePath(filename).toStdString();
-            const size_t length = QFileInfo(filepath.c_str()).size();
-            addFile(Metadata(key, length), filepath);
+
+        // the index only vouches for the files that were here at shutdown, so remove it before anything changes
+        Index index = readIndex();
+        QFile::remove(getIndexFilepath().c_str());
+
+        // load persisted files, the unused ones are ordered by their last use so they don't have to be sorted here
+        size_t numScanned = 0;
+        QDirIterator it(dir.path(), nameFilters, filters);
+        while (it.hasNext()) {
+            const std::string filepath = it.next().toStdString();
+            const Key key = it.fileName().section('.', 0, 0).toStdString();
+
+            auto entry = index.find(key);
+            if (entry != index.end()) {
+                addFile(Metadata(key, entry->second.length), filepath, entry->second.modified);
+            } else {
+                QFileInfo fileInfo(filepath.c_str());
+                addFile(Metadata(key, fileInfo.size()), filepath, fileInfo.lastRead().toMSecsSinceEpoch());
+                ++numScanned;
+            }
         }
 
-        qCDebug(file_cache, "[%s] Initialized %s", _dirname.c_str(), _dirpath.c_str());
+        qCDebug(file_cache, "[%s] Initialized %s, %d of %d files not indexed", _dirname.c_str(), _dirpath.c_str(),
+                (int)numScanned, (int)_numTotalFiles.load());
     } else {
         dir.mkpath(_dirpath.c_str());
         qCDebug(file_cache, "[%s] Created %s", _dirname.c_str(), _dirpath.c_str());
     }
 
     _initialized = true;
+    _cleanThread = std::thread([this] { cleanLoop(); });
+    requestClean();
+}
+
+std::string FileCache::getIndexFilepath() const {
+    return _dirpath + DIR_SEP + INDEX_FILENAME;
+}
+
+FileCache::Index FileCache::readIndex() const {
+    Index index;
+
+    QFile file(getIndexFilepath().c_str());
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return index;
+    }
+
+    QTextStream stream(&file);
+    int version = 0;
+    stream >> version;
+    if (version != INDEX_VERSION) {
+        qCWarning(file_cache, "[%s] Ignoring index of version %d", _dirname.c_str(), version);
+        return index;
+    }
+
+    while (!stream.atEnd()) {
+        QString key;
+        qulonglong length = 0;
+        qint64 modified = 0;
+        stream >> key >> length >> modified;
+        if (stream.status() != QTextStream::Ok || key.isEmpty()) {
+            break;
+        }
+        index[key.toStdString()] = { (size_t)length, modified };
+    }
+    return index;
+}
+
+void FileCache::writeIndex() const {
+    QSaveFile file(getIndexFilepath().c_str());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCWarning(file_cache, "[%s] Failed to write index", _dirname.c_str());
+        return;
+    }
+
+    QTextStream stream(&file);
+    stream << INDEX_VERSION << '\n';
+    for (const auto& entry : _files) {
+        auto cachedFile = entry.second.lock();
+        if (cachedFile) {
+            stream << cachedFile->getKey().c_str() << ' ' << (qulonglong)cachedFile->getLength() << ' '
+                << (qint64)cachedFile->_modified << '\n';
+        }
+    }
+    stream.flush();
+
+    if (stream.status() != QTextStream::Ok || !file.commit()) {
+        qCWarning(file_cache, "[%s] Failed to write index", _dirname.c_str());
+    }
 }
 
 std::unique_ptr<File> FileCache::createFile(Metadata&& metadata, const std::string& filepath) {
     return std::unique_ptr<File>(new cache::File(std::move(metadata), filepath));
 }
 
-FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath) {
+FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath, int64_t modified) {
     File* rawFile = createFile(std::move(metadata), filepath).release();
     FilePointer file(rawFile, std::bind(&File::deleter, rawFile));
     if (file) {
         _numTotalFiles += 1;
         _totalFilesSize += file->getLength();
         file->_parent = shared_from_this();
+        file->_modified = modified;
         file->_locked = true;
         emit dirty();
 
@@ -172,7 +250,7 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
         && saveFile.write(data, metadata.length) == static_cast<qint64>(metadata.length)
         && saveFile.commit()) {
 
-        file = addFile(std::move(metadata), filepath);
+        file = addFile(std::move(metadata), filepath, QDateTime::currentMSecsSinceEpoch());
     } else {
         qCWarning(file_cache, "[%s] Failed to write %s", _dirname.c_str(), metadata.key.c_str());
     }
@@ -195,7 +273,6 @@ FilePointer FileCache::getFile(const Key& key) {
     if (it != _files.cend()) {
         file = it->second.lock();
         if (file) {
-            file->touch();
             // if it exists, it is active - remove it from the cache
             if (_unusedFiles.erase(file)) {
                 assert(!file->_locked);
@@ -214,6 +291,12 @@ FilePointer FileCache::getFile(const Key& key) {
     }
 
     assert(!file || (file->_locked && file->_parent.lock()));
+    lock.unlock();
+
+    // touching the file waits on the disk, and a locked file is out of the unused set, so it is done without the lock
+    if (file) {
+        file->touch();
+    }
     return file;
 }
 
@@ -230,7 +313,7 @@ void FileCache::addUnusedFile(const FilePointer& file) {
     _unusedFiles.insert(file);
     _numUnusedFiles += 1;
     _unusedFilesSize += file->getLength();
-    clean();
+    requestClean();
 
     emit dirty();
 }
@@ -250,17 +333,17 @@ size_t FileCache::getOverbudgetAmount() const {
     return result;
 }
 
-namespace cache {
-    struct FilePointerComparator {
-        bool operator()(const FilePointer& a, const FilePointer& b) {
-            return a->_modified > b->_modified;
-        }
-    };
+bool FilePointerComparator::operator()(const FilePointer& a, const FilePointer& b) const {
+    int64_t aModified = a->_modified;
+    int64_t bModified = b->_modified;
+    return aModified < bModified || (aModified == bModified && a.get() < b.get());
 }
 
 // Take file pointer by value to insure it doesn't get destructed during the "erase()" calls
 void FileCache::eject(FilePointer file) {
+    // an ejected file no longer calls back into the cache when it is released, it just unlinks
     file->_locked = false;
+    file->_parent.reset();
     const auto& length = file->getLength();
     const auto& key = file->getKey();
 
@@ -274,29 +357,74 @@ void FileCache::eject(FilePointer file) {
     }
 }
 
-void FileCache::clean() {
+std::vector<FilePointer> FileCache::clean() {
+    std::vector<FilePointer> ejected;
     size_t overbudgetAmount = getOverbudgetAmount();
 
-    // Avoid sorting the unused files by LRU if we're not over budget / under free space
-    if (0 == overbudgetAmount) {
-        return;
+    // the unused files are kept in LRU order, so the least recently used is always first
+    while (!_unusedFiles.empty() && overbudgetAmount > 0) {
+        auto file = *_unusedFiles.begin();
+        ejected.push_back(file);
+        eject(file);
+        auto length = file->getLength();
+        overbudgetAmount -= std::min(length, overbudgetAmount);
     }
+    return ejected;
+}
+
+void FileCache::requestClean() {
+    std::lock_guard<std::mutex> cleanLock(_cleanMutex);
+    _cleanRequested = true;
+    _cleanCondition.notify_all();
+}
 
-    using Queue = std::priority_queue<FilePointer, std::vector<FilePointer>, FilePointerComparator>;
-    Queue queue;
-    for (const auto& file : _unusedFiles) {
-        queue.push(file);
+void FileCache::cleanLoop() {
+    std::unique_lock<std::mutex> cleanLock(_cleanMutex);
+    while (true) {
+        _cleanCondition.wait(cleanLock, [this] { return _cleanRequested || _stopCleaning; });
+        if (_stopCleaning) {
+            break;
+        }
+        _cleanRequested = false;
+        _cleaning = true;
+        cleanLock.unlock();
+
+        std::vector<FilePointer> ejected;
+        {
+            Lock lock(_mutex);
+            ejected = clean();
+        }
+        if (!ejected.empty()) {
+            // the files unlink as the last references to them go, now that the cache is unlocked
+            ejected.clear();
+            emit dirty();
+        }
+
+        cleanLock.lock();
+        _cleaning = false;
+        _cleanCondition.notify_all();
     }
+}
 
-    while (!queue.empty() && overbudgetAmount > 0) {
-        auto file = queue.top();
-        queue.pop();
-        eject(file);
-        auto length = file->getLength();
-        overbudgetAmount -= std::min(length, overbudgetAmount);
+void FileCache::stopCleaning() {
+    {
+        std::lock_guard<std::mutex> cleanLock(_cleanMutex);
+        _stopCleaning = true;
+        _cleanCondition.notify_all();
+    }
+
+    if (_cleanThread.joinable()) {
+        _cleanThread.join();
     }
 }
 
+void FileCache::waitForClean() {
+    std::unique_lock<std::mutex> cleanLock(_cleanMutex);
+    _cleanCondition.wait(cleanLock, [this] {
+        return (!_cleanRequested && !_cleaning) || _stopCleaning || !_cleanThread.joinable();
+    });
+}
+
 void FileCache::wipe() {
     Lock lock(_mutex);
     while (!_unusedFiles.empty()) {
@@ -310,6 +438,11 @@ void FileCache::clear() {
     // Eliminate any overbudget files
     clean();
 
+    // Everything still in the cache persists, so the next run can restore it from the index
+    if (_initialized) {
+        writeIndex();
+    }
+
     // Mark everything remaining as persisted while effectively ejecting from the cache
     for (auto& file : _unusedFiles) {
         file->_shouldPersist = true;
@@ -332,7 +465,10 @@ void File::deleter(File* file) {
     // If the cache shut down before the file was destroyed, then we should leave the file alone (prevents crash on shutdown)
     FileCachePointer cache = file->_parent.lock();
     if (!cache) {
-        file->_shouldPersist = true;
+        // files the cache ejected were unlocked, and don't persist
+        if (file->_locked) {
+            file->_shouldPersist = true;
+        }
         delete file;
         return;
     }
@@ -344,8 +480,7 @@ void File::deleter(File* file) {
 File::File(Metadata&& metadata, const std::string& filepath) :
     _key(std::move(metadata.key)),
     _length(metadata.length),
-    _filepath(filepath),
-    _modified(QFileInfo(_filepath.c_str()).lastRead().toMSecsSinceEpoch()) {
+    _filepath(filepath) {
 }
 
 File::~File() {
@@ -11,13 +11,17 @@
 #define hifi_FileCache_h
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <cstddef>
 #include <map>
+#include <set>
+#include <thread>
 #include <unordered_set>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <QObject>
 #include <QLoggingCategory>
@@ -34,6 +38,11 @@ class FileCache;
 using FileCachePointer = std::shared_ptr<FileCache>;
 using FileCacheWeakPointer = std::weak_ptr<FileCache>;
 
+// orders files from the least to the most recently used
+struct FilePointerComparator {
+    bool operator()(const FilePointer& a, const FilePointer& b) const;
+};
+
 class FileCache : public QObject, public std::enable_shared_from_this<FileCache> {
     Q_OBJECT
     Q_PROPERTY(size_t numTotal READ getNumTotalFiles NOTIFY dirty)
@@ -92,7 +101,8 @@ signals:
     void dirty();
 
 public:
-    /// must be called after construction to create the cache on the fs and restore persisted files
+    /// must be called after construction to create the cache on the fs and restore persisted files,
+    /// from the index written at shutdown where it has them
     virtual void initialize();
 
     // Add file to the cache and return the cache entry.  
@@ -106,21 +116,39 @@ private:
     using Mutex = std::recursive_mutex;
     using Lock = std::unique_lock<Mutex>;
     using Map = std::unordered_map<Key, std::weak_ptr<File>>;
-    using Set = std::unordered_set<FilePointer>;
+    using Set = std::set<FilePointer, FilePointerComparator>;
     using KeySet = std::unordered_set<Key>;
 
+    struct IndexEntry {
+        size_t length;
+        int64_t modified;
+    };
+    using Index = std::unordered_map<Key, IndexEntry>;
+
     friend class File;
 
     std::string getFilepath(const Key& key);
+    std::string getIndexFilepath() const;
+
+    Index readIndex() const;
+    void writeIndex() const;
 
-    FilePointer addFile(Metadata&& metadata, const std::string& filepath);
+    FilePointer addFile(Metadata&& metadata, const std::string& filepath, int64_t modified);
     void addUnusedFile(const FilePointer& file);
     void releaseFile(File* file);
-    void clean();
+    // Eject unused files, least recently used first, until the cache is back within budget, and return them
+    // so the caller can let them unlink once it has released the lock
+    std::vector<FilePointer> clean();
     void clear();
     // Remove a file from the cache
     void eject(FilePointer file);
 
+    // Eviction runs on a thread of its own, so releasing a file never waits on the disk
+    void requestClean();
+    void cleanLoop();
+    void stopCleaning();
+    void waitForClean();
+
     size_t getOverbudgetAmount() const;
 
     // FIXME it might be desirable to have the min free space variable be static so it can be
@@ -140,6 +168,13 @@ private:
     Mutex _mutex;
     Map _files;
     Set _unusedFiles;
+
+    std::thread _cleanThread;
+    std::mutex _cleanMutex;
+    std::condition_variable _cleanCondition;
+    bool _cleanRequested { false }; // guarded by _cleanMutex
+    bool _cleaning { false }; // guarded by _cleanMutex
+    bool _stopCleaning { false }; // guarded by _cleanMutex
 };
 
 class File {
@@ -170,7 +205,7 @@ private:
 
     void touch();
     FileCacheWeakPointer _parent;
-    int64_t _modified { 0 };
+    std::atomic<int64_t> _modified { 0 };
     bool _locked { false };
 
     bool _shouldPersist { false };
@@ -0,0 +1,144 @@
+//
+//  AssetStorageTests.cpp
+//  tests/assets/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetStorageTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <AssetStorage.h>
+
+QTEST_MAIN(AssetStorageTests)
+
+const int NUM_ASSETS = 50;
+
+static QString assetHash(int i) {
+    return AssetUtils::hashData(QByteArray::number(i)).toHex();
+}
+
+static bool writeFile(const QString& path, const QByteArray& data) {
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+static QByteArray readFile(const QString& path) {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+// keeps NUM_ASSETS assets in a storage of the given layout, each holding its index
+static std::unique_ptr<AssetStorage> createAssets(const QString& layout, const QDir& filesDirectory) {
+    auto storage = AssetStorage::create(layout);
+    if (!storage || !storage->load(filesDirectory)) {
+        return nullptr;
+    }
+    for (int i = 0; i < NUM_ASSETS; ++i) {
+        auto filePath = storage->createFilePath(assetHash(i));
+        if (filePath.isEmpty() || !writeFile(filePath, QByteArray::number(i))) {
+            return nullptr;
+        }
+    }
+    return storage;
+}
+
+static void verifyAssets(const AssetStorage& storage) {
+    auto hashes = storage.getHashes();
+    QCOMPARE(hashes.size(), NUM_ASSETS);
+    for (int i = 0; i < NUM_ASSETS; ++i) {
+        QVERIFY(hashes.contains(assetHash(i)));
+        QCOMPARE(readFile(storage.getFilePath(assetHash(i))), QByteArray::number(i));
+    }
+}
+
+void AssetStorageTests::filePaths() {
+    QTemporaryDir dir;
+    QDir filesDirectory(dir.path());
+    QString hash = assetHash(0);
+
+    auto flat = AssetStorage::create(AssetStorage::FLAT_LAYOUT);
+    QVERIFY(flat->load(filesDirectory));
+    QCOMPARE(flat->getFilePath(hash), filesDirectory.absoluteFilePath(hash));
+
+    auto sharded = AssetStorage::create(AssetStorage::SHARDED_LAYOUT);
+    QVERIFY(sharded->load(filesDirectory));
+    QCOMPARE(sharded->getFilePath(hash), filesDirectory.absoluteFilePath(hash.left(2) + "/" + hash));
+    QVERIFY(!sharded->createFilePath(hash).isEmpty());
+    QVERIFY(filesDirectory.exists(hash.left(2)));
+
+    QVERIFY(!AssetStorage::create("unknown"));
+}
+
+void AssetStorageTests::migrateToSharded() {
+    QTemporaryDir dir;
+    QDir filesDirectory(dir.path());
+    QVERIFY(createAssets(AssetStorage::FLAT_LAYOUT, filesDirectory));
+
+    // files that aren't assets are left where they are
+    QVERIFY(writeFile(filesDirectory.filePath("map.json"), "{}"));
+
+    auto sharded = AssetStorage::create(AssetStorage::SHARDED_LAYOUT);
+    QVERIFY(sharded->load(filesDirectory));
+    verifyAssets(*sharded);
+    for (int i = 0; i < NUM_ASSETS; ++i) {
+        QVERIFY(!filesDirectory.exists(assetHash(i)));
+    }
+    QVERIFY(filesDirectory.exists("map.json"));
+}
+
+void AssetStorageTests::migrateToFlat() {
+    QTemporaryDir dir;
+    QDir filesDirectory(dir.path());
+    QVERIFY(createAssets(AssetStorage::SHARDED_LAYOUT, filesDirectory));
+
+    auto flat = AssetStorage::create(AssetStorage::FLAT_LAYOUT);
+    QVERIFY(flat->load(filesDirectory));
+    verifyAssets(*flat);
+
+    // the shards are gone once they are empty
+    QCOMPARE(filesDirectory.entryList(QDir::Dirs | QDir::NoDotAndDotDot), QStringList());
+}
+
+void AssetStorageTests::keepExistingFile() {
+    QTemporaryDir dir;
+    QDir filesDirectory(dir.path());
+    auto sharded = createAssets(AssetStorage::SHARDED_LAYOUT, filesDirectory);
+    QVERIFY(sharded);
+
+    // a copy of an asset left behind in the flat layout gives way to the one in its shard
+    QString hash = assetHash(0);
+    QVERIFY(writeFile(filesDirectory.filePath(hash), "left behind"));
+
+    sharded = AssetStorage::create(AssetStorage::SHARDED_LAYOUT);
+    QVERIFY(sharded->load(filesDirectory));
+    verifyAssets(*sharded);
+    QVERIFY(!filesDirectory.exists(hash));
+}
+
+void AssetStorageTests::failedMigration() {
+    QTemporaryDir dir;
+    QDir filesDirectory(dir.path());
+    QVERIFY(createAssets(AssetStorage::FLAT_LAYOUT, filesDirectory));
+
+    // a shard the files can't be moved into
+    QString shardName = assetHash(0).left(2);
+    QVERIFY(filesDirectory.mkdir(shardName));
+    QString shardPath = filesDirectory.filePath(shardName);
+    QVERIFY(QFile::setPermissions(shardPath, QFile::ReadOwner | QFile::ExeOwner));
+    if (QFileInfo(shardPath).isWritable()) {
+        QSKIP("Directory permissions are not enforced for this user");
+    }
+
+    auto sharded = AssetStorage::create(AssetStorage::SHARDED_LAYOUT);
+    bool loaded = sharded->load(filesDirectory);
+    QFile::setPermissions(shardPath, QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+
+    QVERIFY(!loaded);
+    QVERIFY(filesDirectory.exists(assetHash(0)));
+}
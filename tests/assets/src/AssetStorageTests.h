@@ -0,0 +1,27 @@
+//
+//  AssetStorageTests.h
+//  tests/assets/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetStorageTests_h
+#define hifi_AssetStorageTests_h
+
+#include <QtTest/QtTest>
+
+class AssetStorageTests : public QObject {
+    Q_OBJECT
+private slots:
+    void filePaths();
+    void migrateToSharded();
+    void migrateToFlat();
+    void keepExistingFile();
+    void failedMigration();
+};
+
+#endif // hifi_AssetStorageTests_h
@@ -0,0 +1,83 @@
+//
+//  AssetUtilsTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetUtilsTests.h"
+
+#include <random>
+
+#include <AssetUtils.h>
+
+QTEST_MAIN(AssetUtilsTests)
+
+static QByteArray randomData(int size, unsigned int seed) {
+    std::mt19937 generator(seed);
+    QByteArray data(size, 0);
+    for (auto& byte : data) {
+        byte = (char)generator();
+    }
+    return data;
+}
+
+void AssetUtilsTests::chunksCoverData() {
+    auto data = randomData(4 * 1000 * 1000, 1);
+    auto chunks = AssetUtils::chunkData(data);
+    QVERIFY(chunks.size() > 1);
+
+    // the chunks follow each other, and only the last one may be shorter than the minimum
+    AssetUtils::DataOffset offset = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto& chunk = chunks[i];
+        QCOMPARE(chunk.offset, offset);
+        QVERIFY(chunk.length <= AssetUtils::MAX_CHUNK_SIZE);
+        QVERIFY(chunk.length >= AssetUtils::MIN_CHUNK_SIZE || i == chunks.size() - 1);
+        QCOMPARE(chunk.hash, AssetUtils::hashData(data.mid(chunk.offset, chunk.length)));
+        offset += chunk.length;
+    }
+    QCOMPARE(offset, (AssetUtils::DataOffset)data.size());
+
+    // the same data is always chunked the same way
+    auto again = AssetUtils::chunkData(data);
+    QCOMPARE(again.size(), chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        QCOMPARE(again[i].hash, chunks[i].hash);
+    }
+}
+
+void AssetUtilsTests::chunksAreContentDefined() {
+    auto data = randomData(4 * 1000 * 1000, 2);
+    auto chunks = AssetUtils::chunkData(data);
+
+    // an edit near the start shifts everything after it, but only the chunks around it change
+    auto edited = data;
+    edited.insert(100 * 1000, "edit");
+    auto editedChunks = AssetUtils::chunkData(edited);
+
+    QSet<QByteArray> hashes;
+    for (const auto& chunk : chunks) {
+        hashes.insert(chunk.hash);
+    }
+    size_t numChanged = 0;
+    for (const auto& chunk : editedChunks) {
+        numChanged += hashes.contains(chunk.hash) ? 0 : 1;
+    }
+    QVERIFY(numChanged <= 2);
+}
+
+void AssetUtilsTests::smallData() {
+    QVERIFY(AssetUtils::chunkData(QByteArray()).empty());
+
+    auto data = randomData(1000, 3);
+    auto chunks = AssetUtils::chunkData(data);
+    QCOMPARE(chunks.size(), (size_t)1);
+    QCOMPARE(chunks[0].offset, (AssetUtils::DataOffset)0);
+    QCOMPARE(chunks[0].length, (int64_t)data.size());
+    QCOMPARE(chunks[0].hash, AssetUtils::hashData(data));
+}
@@ -0,0 +1,25 @@
+//
+//  AssetUtilsTests.h
+//  tests/networking/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetUtilsTests_h
+#define hifi_AssetUtilsTests_h
+
+#include <QtTest/QtTest>
+
+class AssetUtilsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void chunksCoverData();
+    void chunksAreContentDefined();
+    void smallData();
+};
+
+#endif // hifi_AssetUtilsTests_h
@@ -0,0 +1,138 @@
+//
+//  CoarseVisibilityTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CoarseVisibilityTests.h"
+
+#include <set>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <CoarseVisibility.h>
+#include <DiffTraversal.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <ViewFrustum.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(CoarseVisibilityTests)
+
+const float WORLD_WIDTH = 400.0f;
+const uint64_t TRAVERSAL_BUDGET = 60 * USECS_PER_SECOND;
+
+static EntityTreePointer buildScene(int numEntities) {
+    auto tree = createEntityTree();
+    addRandomBoxes(tree, numEntities, WORLD_WIDTH, 0.05f, 2.05f);
+    return tree;
+}
+
+static DiffTraversal::View makeView(const glm::vec3& position, float lodScaleFactor) {
+    ViewFrustum frustum;
+    frustum.setProjection(glm::perspective(PI / 2.0f, 1.0f, 0.1f, 500.0f));
+    frustum.setPosition(position);
+    frustum.setOrientation(glm::angleAxis(TWO_PI * randFloat(), glm::normalize(glm::vec3(randFloat(), 1.0f, randFloat()))));
+    frustum.setCenterRadius(1.0f);
+    frustum.calculate();
+
+    DiffTraversal::View view;
+    view.viewFrustums.push_back(ConicalViewFrustum(frustum));
+    view.lodScaleFactor = lodScaleFactor;
+    return view;
+}
+
+static std::set<EntityTreeElement*> scanFirstTraversal(const DiffTraversal::View& view, const EntityTreePointer& tree,
+                                                      CoarseVisibilityCache* cache) {
+    std::set<EntityTreeElement*> scanned;
+    DiffTraversal traversal;
+    traversal.prepareNewTraversal(view, tree->getRoot(), cache);
+    traversal.setScanCallback([&](DiffTraversal::VisibleElement& next) {
+        scanned.insert(next.element.get());
+    });
+    traversal.traverse(TRAVERSAL_BUDGET);
+    return traversal.finished() ? scanned : std::set<EntityTreeElement*>();
+}
+
+// two traversals asking for the cell of a view have the cache build its pass
+static CoarseVisibilityPointer shareCell(CoarseVisibilityCache& cache, const DiffTraversal::View& view,
+                                         const EntityTreePointer& tree) {
+    int firstTraversal, secondTraversal;
+    cache.get(view, tree->getRoot(), &firstTraversal);
+    cache.get(view, tree->getRoot(), &secondTraversal);
+    cache.waitForBuilds();
+    return cache.get(view, tree->getRoot(), &firstTraversal);
+}
+
+void CoarseVisibilityTests::testMatchesTreeWalk() {
+    auto tree = buildScene(5000);
+    const uint64_t MAX_AGE = 60 * USECS_PER_SECOND;
+    CoarseVisibilityCache cache(CoarseVisibilityCache::DEFAULT_CELL_SIZE, MAX_AGE);
+
+    // a traversal over the coarse visibility finds the same elements as one over the tree
+    const int NUM_VIEWS = 50;
+    for (int i = 0; i < NUM_VIEWS; ++i) {
+        glm::vec3 position = WORLD_WIDTH * glm::vec3(randFloat() - 0.5f, randFloat() - 0.5f, randFloat() - 0.5f);
+        float lodScaleFactor = (i % 2) ? 1.0f : 4.0f;
+        auto view = makeView(position, lodScaleFactor);
+        QVERIFY(shareCell(cache, view, tree));
+
+        size_t numHits = cache.getNumHits();
+        auto fromTree = scanFirstTraversal(view, tree, nullptr);
+        auto fromCoarse = scanFirstTraversal(view, tree, &cache);
+        QCOMPARE(cache.getNumHits(), numHits + 1);
+        QVERIFY(!fromTree.empty());
+        QVERIFY(fromTree == fromCoarse);
+    }
+}
+
+void CoarseVisibilityTests::testSharedWithinCell() {
+    auto tree = buildScene(500);
+    const float CELL_SIZE = 16.0f;
+    const uint64_t MAX_AGE = 60 * USECS_PER_SECOND;
+    CoarseVisibilityCache cache(CELL_SIZE, MAX_AGE);
+
+    // a view alone in its cell walks the tree, however often it asks
+    int firstTraversal, secondTraversal;
+    glm::vec3 cellCorner(32.0f, 0.0f, -16.0f);
+    auto firstView = makeView(cellCorner + glm::vec3(1.0f), 1.0f);
+    QVERIFY(!cache.get(firstView, tree->getRoot(), &firstTraversal));
+    QVERIFY(!cache.get(firstView, tree->getRoot(), &firstTraversal));
+    cache.waitForBuilds();
+    QCOMPARE(cache.getNumBuilds(), (size_t)0);
+
+    // a second view in the cell has the pass built off its traversal, for both to use
+    auto secondView = makeView(cellCorner + glm::vec3(CELL_SIZE - 1.0f), 1.0f);
+    QVERIFY(!cache.get(secondView, tree->getRoot(), &secondTraversal));
+    cache.waitForBuilds();
+    auto first = cache.get(firstView, tree->getRoot(), &firstTraversal);
+    auto second = cache.get(secondView, tree->getRoot(), &secondTraversal);
+    QVERIFY(first);
+    QVERIFY(first == second);
+    QCOMPARE(cache.getNumBuilds(), (size_t)1);
+    QCOMPARE(cache.getNumHits(), (size_t)2);
+
+    // another cell or another LOD gets its own pass
+    auto otherCell = shareCell(cache, makeView(cellCorner + glm::vec3(CELL_SIZE + 1.0f), 1.0f), tree);
+    auto otherLOD = shareCell(cache, makeView(cellCorner + glm::vec3(1.0f), 2.0f), tree);
+    QVERIFY(otherCell && otherCell != first);
+    QVERIFY(otherLOD && otherLOD != first);
+    QCOMPARE(cache.getNumBuilds(), (size_t)3);
+
+    // views without frustums walk the tree
+    QVERIFY(!cache.get(DiffTraversal::View(), tree->getRoot(), &firstTraversal));
+
+    // the root comes first and every subtree ends inside the list
+    const auto& entries = first->getEntries();
+    QVERIFY(entries.front().element == tree->getRoot());
+    QCOMPARE((size_t)entries.front().subtreeEnd, entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        QVERIFY(entries[i].subtreeEnd > i && entries[i].subtreeEnd <= entries.size());
+    }
+}
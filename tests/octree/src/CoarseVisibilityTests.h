@@ -0,0 +1,25 @@
+//
+//  CoarseVisibilityTests.h
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CoarseVisibilityTests_h
+#define hifi_CoarseVisibilityTests_h
+
+#include <QtTest/QtTest>
+
+class CoarseVisibilityTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testMatchesTreeWalk();
+    void testSharedWithinCell();
+};
+
+#endif // hifi_CoarseVisibilityTests_h
@@ -0,0 +1,219 @@
+//
+//  EntityEditCoalescingTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditCoalescingTests.h"
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <ReceivedMessage.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityEditCoalescingTests)
+
+const uint64_t LONG_WINDOW = 60 * USECS_PER_SECOND; // never expires while a test runs
+const uint64_t SHORT_WINDOW = 200 * USECS_PER_MSEC;
+const glm::vec3 START_POSITION = glm::vec3(10.0f);
+
+using HeldEdits = std::vector<Octree::HeldEdit>;
+
+static EntityTreePointer createServerTree() {
+    auto tree = createEntityTree();
+    tree->setIsServer(true);
+    return tree;
+}
+
+static SharedNodePointer createSender() {
+    SharedNodePointer sender(new Node(QUuid::createUuid(), NodeType::Agent, HifiSockAddr(), HifiSockAddr()));
+    NodePermissions permissions;
+    permissions.setAll(true);
+    sender->setPermissions(permissions);
+    return sender;
+}
+
+static EntityItemProperties moveTo(const glm::vec3& position) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(position);
+    properties.setLastEdited(usecTimestampNow());
+    return properties;
+}
+
+static QSharedPointer<ReceivedMessage> editMessage(const EntityItemID& entityID, const EntityItemProperties& properties) {
+    QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityEdit), 0);
+    EntityPropertyFlags didntFitProperties;
+    EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, entityID, properties, buffer,
+                                                 properties.getChangedProperties(), didntFitProperties);
+    return QSharedPointer<ReceivedMessage>::create(buffer, PacketType::EntityEdit,
+                                                   versionForPacketType(PacketType::EntityEdit), HifiSockAddr());
+}
+
+static bool hold(const EntityTreePointer& tree, const QSharedPointer<ReceivedMessage>& message,
+                 const SharedNodePointer& sender, HeldEdits& readyEdits) {
+    auto editData = reinterpret_cast<const unsigned char*>(message->getRawMessage());
+    int bytesRead = 0;
+    bool held = false;
+    tree->withReadLock([&] {
+        held = tree->holdEditPacketData(message, editData, (int)message->getSize(), sender, bytesRead, readyEdits);
+    });
+    return held;
+}
+
+// what the inbound packet processor does with the edits the tree releases
+static void apply(const EntityTreePointer& tree, HeldEdits& readyEdits) {
+    for (auto& readyEdit : readyEdits) {
+        auto editData = reinterpret_cast<const unsigned char*>(readyEdit.message->getRawMessage() + readyEdit.offset);
+        tree->withWriteLock([&] {
+            tree->processEditPacketData(*readyEdit.message, editData, readyEdit.length, readyEdit.sourceNode);
+        });
+    }
+    readyEdits.clear();
+}
+
+void EntityEditCoalescingTests::initTestCase() {
+    // applying edits checks simulation ownership against our session
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityEditCoalescingTests::testOffByDefault() {
+    auto tree = createServerTree();
+    auto entity = addBox(tree, START_POSITION, glm::vec3(1.0f));
+    auto sender = createSender();
+    QCOMPARE(tree->getEditCoalescingWindow(EntityTypes::Box), EntityTree::DEFAULT_EDIT_COALESCING_WINDOW);
+    QCOMPARE(EntityTree::DEFAULT_EDIT_COALESCING_WINDOW, (uint64_t)0);
+
+    HeldEdits readyEdits;
+    QVERIFY(!hold(tree, editMessage(entity->getEntityItemID(), moveTo(glm::vec3(1.0f))), sender, readyEdits));
+    QVERIFY(readyEdits.empty());
+    QCOMPARE(tree->getNextHeldEditRelease(), (uint64_t)0);
+}
+
+void EntityEditCoalescingTests::testMerge() {
+    auto tree = createServerTree();
+    tree->setEditCoalescingWindow(LONG_WINDOW);
+    auto entity = addBox(tree, START_POSITION, glm::vec3(1.0f));
+    auto sender = createSender();
+
+    HeldEdits readyEdits;
+    QVERIFY(hold(tree, editMessage(entity->getEntityItemID(), moveTo(glm::vec3(1.0f))), sender, readyEdits));
+    auto lastMessage = editMessage(entity->getEntityItemID(), moveTo(glm::vec3(2.0f)));
+    QVERIFY(hold(tree, lastMessage, sender, readyEdits));
+
+    // the second edit sets everything the first did, so only it is left to apply
+    QVERIFY(readyEdits.empty());
+    QVERIFY(entity->getWorldPosition() == START_POSITION);
+
+    tree->releaseHeldEdits(true, readyEdits);
+    QCOMPARE((int)readyEdits.size(), 1);
+    QVERIFY(readyEdits[0].message == lastMessage);
+    QVERIFY(readyEdits[0].sourceNode == sender);
+
+    apply(tree, readyEdits);
+    QVERIFY(entity->getWorldPosition() == glm::vec3(2.0f));
+}
+
+void EntityEditCoalescingTests::testNotSuperseded() {
+    auto tree = createServerTree();
+    tree->setEditCoalescingWindow(LONG_WINDOW);
+    auto entity = addBox(tree, START_POSITION, glm::vec3(1.0f));
+    auto sender = createSender();
+
+    auto properties = moveTo(glm::vec3(1.0f));
+    properties.setVelocity(glm::vec3(0.0f, 1.0f, 0.0f));
+    auto firstMessage = editMessage(entity->getEntityItemID(), properties);
+    auto secondMessage = editMessage(entity->getEntityItemID(), moveTo(glm::vec3(2.0f)));
+
+    HeldEdits readyEdits;
+    QVERIFY(hold(tree, firstMessage, sender, readyEdits));
+    QVERIFY(hold(tree, secondMessage, sender, readyEdits));
+
+    // the second edit leaves the velocity alone, so the first has to be applied before it
+    QCOMPARE((int)readyEdits.size(), 1);
+    QVERIFY(readyEdits[0].message == firstMessage);
+
+    // an edit from another sender never replaces a held one either
+    auto otherMessage = editMessage(entity->getEntityItemID(), moveTo(glm::vec3(3.0f)));
+    QVERIFY(hold(tree, otherMessage, createSender(), readyEdits));
+    QCOMPARE((int)readyEdits.size(), 2);
+    QVERIFY(readyEdits[1].message == secondMessage);
+    QCOMPARE(tree->getTotalCoalescedEdits(), (quint64)0);
+
+    tree->releaseHeldEdits(true, readyEdits);
+    QCOMPARE((int)readyEdits.size(), 3);
+    apply(tree, readyEdits);
+    QVERIFY(entity->getWorldPosition() == glm::vec3(3.0f));
+    QVERIFY(entity->getWorldVelocity() == glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+void EntityEditCoalescingTests::testWindowExpiry() {
+    auto tree = createServerTree();
+    tree->setEditCoalescingWindow(SHORT_WINDOW);
+    auto entity = addBox(tree, START_POSITION, glm::vec3(1.0f));
+    auto sender = createSender();
+
+    uint64_t heldAt = usecTimestampNow();
+    HeldEdits readyEdits;
+    QVERIFY(hold(tree, editMessage(entity->getEntityItemID(), moveTo(glm::vec3(1.0f))), sender, readyEdits));
+    uint64_t nextRelease = tree->getNextHeldEditRelease();
+    QVERIFY(nextRelease >= heldAt + SHORT_WINDOW);
+
+    // an edit that replaces a held one keeps its release time, so a continuously edited entity is still updated
+    QVERIFY(hold(tree, editMessage(entity->getEntityItemID(), moveTo(glm::vec3(2.0f))), sender, readyEdits));
+    QCOMPARE(tree->getNextHeldEditRelease(), nextRelease);
+
+    tree->releaseHeldEdits(false, readyEdits);
+    if (usecTimestampNow() < nextRelease) {
+        // it isn't due yet
+        QVERIFY(readyEdits.empty());
+        while (usecTimestampNow() < nextRelease) {
+            QThread::msleep(1);
+        }
+        tree->releaseHeldEdits(false, readyEdits);
+    }
+    QCOMPARE((int)readyEdits.size(), 1);
+    QCOMPARE(tree->getNextHeldEditRelease(), (uint64_t)0);
+
+    apply(tree, readyEdits);
+    QVERIFY(entity->getWorldPosition() == glm::vec3(2.0f));
+}
+
+void EntityEditCoalescingTests::testCoalescedStats() {
+    const int NUM_EDITS = 10;
+
+    auto tree = createServerTree();
+    tree->setEditCoalescingWindow(LONG_WINDOW);
+    auto first = addBox(tree, START_POSITION, glm::vec3(1.0f));
+    auto second = addBox(tree, -START_POSITION, glm::vec3(1.0f));
+    auto sender = createSender();
+
+    // the edits of one entity never replace those of another
+    HeldEdits readyEdits;
+    for (int i = 0; i < NUM_EDITS; ++i) {
+        QVERIFY(hold(tree, editMessage(first->getEntityItemID(), moveTo(glm::vec3((float)i))), sender, readyEdits));
+        QVERIFY(hold(tree, editMessage(second->getEntityItemID(), moveTo(glm::vec3((float)-i))), sender, readyEdits));
+    }
+    QVERIFY(readyEdits.empty());
+    QCOMPARE(tree->getTotalCoalescedEdits(), (quint64)(2 * (NUM_EDITS - 1)));
+
+    tree->releaseHeldEdits(true, readyEdits);
+    QCOMPARE((int)readyEdits.size(), 2);
+    apply(tree, readyEdits);
+    QVERIFY(first->getWorldPosition() == glm::vec3((float)(NUM_EDITS - 1)));
+    QVERIFY(second->getWorldPosition() == glm::vec3((float)-(NUM_EDITS - 1)));
+
+    tree->resetEditStats();
+    QCOMPARE(tree->getTotalCoalescedEdits(), (quint64)0);
+}
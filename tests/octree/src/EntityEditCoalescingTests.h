@@ -0,0 +1,29 @@
+//
+//  EntityEditCoalescingTests.h
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditCoalescingTests_h
+#define hifi_EntityEditCoalescingTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditCoalescingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testOffByDefault();
+    void testMerge();
+    void testNotSuperseded();
+    void testWindowExpiry();
+    void testCoalescedStats();
+};
+
+#endif // hifi_EntityEditCoalescingTests_h
@@ -0,0 +1,202 @@
+//
+//  EntityPersistJournalTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPersistJournalTests.h"
+
+#include <QTemporaryDir>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <NodeList.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityPersistJournalTests)
+
+const int NUM_ENTITIES = 200;
+const float WORLD_WIDTH = 100.0f;
+
+static EntityTreePointer createTree() {
+    return createEntityTree();
+}
+
+static EntityItemPointer addBox(const EntityTreePointer& tree, const glm::vec3& position) {
+    return addBox(tree, position, glm::vec3(1.0f), QString("box %1").arg(position.x));
+}
+
+static QHash<EntityItemID, glm::vec3> buildScene(const EntityTreePointer& tree) {
+    QHash<EntityItemID, glm::vec3> positions;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        glm::vec3 position = WORLD_WIDTH * glm::vec3(randFloat(), randFloat(), randFloat());
+        auto entity = addBox(tree, position);
+        positions[entity->getEntityItemID()] = position;
+    }
+    return positions;
+}
+
+static int countEntities(const EntityTreePointer& tree) {
+    int count = 0;
+    tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+        std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](EntityItemPointer entity) {
+            ++count;
+        });
+        return true;
+    });
+    return count;
+}
+
+static bool load(const EntityTreePointer& tree, const QString& filename, const QUuid& persistID, int64_t dataVersion) {
+    bool loaded = false;
+    tree->withWriteLock([&] {
+        loaded = tree->readFromPersistJournal(filename);
+    });
+    return loaded && tree->getPersistID() == persistID && tree->getPersistDataVersion() == dataVersion;
+}
+
+static void verifyScene(const EntityTreePointer& tree, const QHash<EntityItemID, glm::vec3>& positions) {
+    QCOMPARE(countEntities(tree), positions.size());
+    for (auto it = positions.cbegin(); it != positions.cend(); ++it) {
+        auto entity = tree->findEntityByEntityItemID(it.key());
+        QVERIFY(entity);
+        QCOMPARE(entity->getType(), EntityTypes::Box);
+        QVERIFY(entity->getWorldPosition() == it.value());
+    }
+}
+
+void EntityPersistJournalTests::initTestCase() {
+    // decoding entities checks simulation ownership against our session
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityPersistJournalTests::testRoundTrip() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.journal");
+    QUuid persistID = QUuid::createUuid();
+
+    auto tree = createTree();
+    auto positions = buildScene(tree);
+    tree->setOctreeVersionInfo(persistID, 1);
+    QVERIFY(tree->writeToPersistJournal(filename));
+
+    auto loaded = createTree();
+    QVERIFY(load(loaded, filename, persistID, 1));
+    verifyScene(loaded, positions);
+}
+
+void EntityPersistJournalTests::testAppend() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.journal");
+    QUuid persistID = QUuid::createUuid();
+
+    auto tree = createTree();
+    auto positions = buildScene(tree);
+    tree->setOctreeVersionInfo(persistID, 1);
+    QVERIFY(tree->writeToPersistJournal(filename));
+    qint64 initialSize = QFileInfo(filename).size();
+
+    // move one entity, delete another and add a third
+    auto it = positions.begin();
+    auto moved = tree->findEntityByEntityItemID(it.key());
+    glm::vec3 newPosition = it.value() + glm::vec3(0.01f);
+    moved->setWorldPosition(newPosition);
+    moved->markAsChangedOnServer();
+    it.value() = newPosition;
+
+    ++it;
+    EntityItemID deletedID = it.key();
+    tree->withWriteLock([&] {
+        tree->deleteEntity(deletedID, true);
+    });
+    positions.erase(it);
+
+    auto added = addBox(tree, glm::vec3(WORLD_WIDTH / 2.0f));
+    positions[added->getEntityItemID()] = glm::vec3(WORLD_WIDTH / 2.0f);
+
+    tree->incrementPersistDataVersion();
+    QVERIFY(tree->writeToPersistJournal(filename));
+
+    // only the changes were appended
+    qint64 appendedSize = QFileInfo(filename).size() - initialSize;
+    QVERIFY(appendedSize > 0);
+    QVERIFY(appendedSize < initialSize / 10);
+
+    auto loaded = createTree();
+    QVERIFY(load(loaded, filename, persistID, 2));
+    verifyScene(loaded, positions);
+    QVERIFY(!loaded->findEntityByEntityItemID(deletedID));
+}
+
+void EntityPersistJournalTests::testJournalInfo() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.journal");
+    QUuid persistID = QUuid::createUuid();
+
+    auto tree = createTree();
+    buildScene(tree);
+    tree->setOctreeVersionInfo(persistID, 1);
+    QVERIFY(tree->writeToPersistJournal(filename));
+
+    // the header follows the last commit, both when the journal is rewritten and appended to
+    OctreeUtils::RawOctreeData data;
+    QVERIFY(tree->readPersistJournalInfo(filename, data));
+    QCOMPARE(data.id, persistID);
+    QCOMPARE(data.dataVersion, (OctreeUtils::Version)1);
+    QCOMPARE(data.version, (OctreeUtils::Version)tree->expectedVersion());
+
+    addBox(tree, glm::vec3(WORLD_WIDTH / 2.0f));
+    tree->incrementPersistDataVersion();
+    QVERIFY(tree->writeToPersistJournal(filename));
+    QVERIFY(tree->readPersistJournalInfo(filename, data));
+    QCOMPARE(data.id, persistID);
+    QCOMPARE(data.dataVersion, (OctreeUtils::Version)2);
+
+    // nothing to read or load where there is no journal
+    auto loaded = createTree();
+    QVERIFY(!loaded->readPersistJournalInfo(dir.filePath("missing.journal"), data));
+    QVERIFY(!load(loaded, dir.filePath("missing.journal"), persistID, 2));
+    QCOMPARE(countEntities(loaded), 0);
+}
+
+void EntityPersistJournalTests::testUnfinishedWrite() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.journal");
+    QUuid persistID = QUuid::createUuid();
+
+    auto tree = createTree();
+    auto positions = buildScene(tree);
+    tree->setOctreeVersionInfo(persistID, 1);
+    QVERIFY(tree->writeToPersistJournal(filename));
+
+    // a write that stopped part way through a record
+    {
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::Append));
+        const char partialRecord[] = { 1, 100, 0, 0, 0, 42 };
+        file.write(partialRecord, sizeof(partialRecord));
+    }
+
+    auto loaded = createTree();
+    QVERIFY(load(loaded, filename, persistID, 1));
+    verifyScene(loaded, positions);
+
+    // the next write from the loaded tree replaces the partial record
+    auto added = addBox(loaded, glm::vec3(WORLD_WIDTH / 2.0f));
+    positions[added->getEntityItemID()] = glm::vec3(WORLD_WIDTH / 2.0f);
+    loaded->incrementPersistDataVersion();
+    QVERIFY(loaded->writeToPersistJournal(filename));
+
+    auto reloaded = createTree();
+    QVERIFY(load(reloaded, filename, persistID, 2));
+    verifyScene(reloaded, positions);
+}
@@ -0,0 +1,28 @@
+//
+//  EntityPersistJournalTests.h
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPersistJournalTests_h
+#define hifi_EntityPersistJournalTests_h
+
+#include <QtTest/QtTest>
+
+class EntityPersistJournalTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testRoundTrip();
+    void testAppend();
+    void testJournalInfo();
+    void testUnfinishedWrite();
+};
+
+#endif // hifi_EntityPersistJournalTests_h
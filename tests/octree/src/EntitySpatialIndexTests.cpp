@@ -0,0 +1,156 @@
+//
+//  EntitySpatialIndexTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndexTests.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntitySpatialIndexTests)
+
+const float WORLD_WIDTH = 1000.0f;
+const float MIN_DIMENSION = 0.1f;
+const float MAX_DIMENSION = 10.0f;
+
+// builds the same scene in a tree that uses the spatial index and one that recurses the octree
+static void buildScenes(int numEntities, float largeFraction, EntityTreePointer& indexed, EntityTreePointer& recursed) {
+    indexed = createEntityTree(true);
+    recursed = createEntityTree(false);
+
+    for (int i = 0; i < numEntities; ++i) {
+        glm::vec3 position = randomPosition(WORLD_WIDTH);
+        glm::vec3 dimensions = glm::vec3(MIN_DIMENSION + (MAX_DIMENSION - MIN_DIMENSION) * randFloat());
+        if (randFloat() < largeFraction) {
+            dimensions *= 50.0f;
+        }
+        addBox(indexed, position, dimensions);
+        addBox(recursed, position, dimensions);
+    }
+}
+
+static std::vector<glm::vec3> sortedPositions(const QVector<EntityItemPointer>& entities) {
+    std::vector<glm::vec3> positions;
+    for (const auto& entity : entities) {
+        positions.push_back(entity->getWorldPosition());
+    }
+    std::sort(positions.begin(), positions.end(), [](const glm::vec3& a, const glm::vec3& b) {
+        return a.x < b.x || (a.x == b.x && (a.y < b.y || (a.y == b.y && a.z < b.z)));
+    });
+    return positions;
+}
+
+void EntitySpatialIndexTests::testMatchesOctree() {
+    EntityTreePointer indexed;
+    EntityTreePointer recursed;
+    buildScenes(2000, 0.05f, indexed, recursed);
+
+    const int NUM_QUERIES = 200;
+    for (int i = 0; i < NUM_QUERIES; ++i) {
+        glm::vec3 center = randomPosition(WORLD_WIDTH);
+        float radius = 1.0f + 100.0f * randFloat();
+
+        QVector<EntityItemPointer> fromIndex;
+        QVector<EntityItemPointer> fromOctree;
+
+        indexed->findEntities(center, radius, fromIndex);
+        recursed->findEntities(center, radius, fromOctree);
+        QCOMPARE(sortedPositions(fromIndex) == sortedPositions(fromOctree), true);
+
+        AACube cube(center - glm::vec3(radius), 2.0f * radius);
+        indexed->findEntities(cube, fromIndex);
+        recursed->findEntities(cube, fromOctree);
+        QCOMPARE(sortedPositions(fromIndex) == sortedPositions(fromOctree), true);
+
+        AABox box(center, glm::vec3(radius, 0.5f * radius, 2.0f * radius));
+        indexed->findEntities(box, fromIndex);
+        recursed->findEntities(box, fromOctree);
+        QCOMPARE(sortedPositions(fromIndex) == sortedPositions(fromOctree), true);
+    }
+}
+
+void EntitySpatialIndexTests::testRemove() {
+    EntitySpatialIndex index;
+    auto tree = createEntityTree(false);
+    glm::vec3 position(10.0f, 20.0f, 30.0f);
+    auto entity = addBox(tree, position, glm::vec3(1.0f));
+
+    index.insert(entity, AACube(position - glm::vec3(2.0f), 4.0f));
+    QCOMPARE(index.size(), (size_t)1);
+
+    int found = 0;
+    index.forEachCandidate(AABox(position, 1.0f), [&](const EntityItemPointer&, const AACube&) {
+        ++found;
+    });
+    QCOMPARE(found, 1);
+
+    // re-inserting moves the entry instead of adding another one
+    glm::vec3 newPosition(-100.0f, 0.0f, 0.0f);
+    index.insert(entity, AACube(newPosition, 4.0f));
+    QCOMPARE(index.size(), (size_t)1);
+
+    found = 0;
+    index.forEachCandidate(AABox(position, 1.0f), [&](const EntityItemPointer&, const AACube&) {
+        ++found;
+    });
+    QCOMPARE(found, 0);
+
+    index.remove(entity.get());
+    QCOMPARE(index.size(), (size_t)0);
+    QCOMPARE(index.numOccupiedCells(), (size_t)0);
+}
+
+#ifdef MANUAL_TEST
+void EntitySpatialIndexTests::benchmark() {
+    const int NUM_ENTITIES = 100000;
+    const int NUM_QUERIES = 1000;
+    const float QUERY_RADIUS = 20.0f;
+
+    EntityTreePointer indexed;
+    EntityTreePointer recursed;
+    buildScenes(NUM_ENTITIES, 0.01f, indexed, recursed);
+
+    std::vector<glm::vec3> centers;
+    for (int i = 0; i < NUM_QUERIES; ++i) {
+        centers.push_back(randomPosition(WORLD_WIDTH));
+    }
+
+    auto timeQueries = [&](const EntityTreePointer& tree, uint64_t& sphereUsecs, uint64_t& boxUsecs) {
+        QVector<EntityItemPointer> found;
+        uint64_t startTime = usecTimestampNow();
+        for (const auto& center : centers) {
+            tree->withReadLock([&] {
+                tree->findEntities(center, QUERY_RADIUS, found);
+            });
+        }
+        sphereUsecs = usecTimestampNow() - startTime;
+
+        startTime = usecTimestampNow();
+        for (const auto& center : centers) {
+            tree->withReadLock([&] {
+                tree->findEntities(AABox(center, 2.0f * QUERY_RADIUS), found);
+            });
+        }
+        boxUsecs = usecTimestampNow() - startTime;
+    };
+
+    uint64_t indexedSphereUsecs, indexedBoxUsecs, recursedSphereUsecs, recursedBoxUsecs;
+    timeQueries(indexed, indexedSphereUsecs, indexedBoxUsecs);
+    timeQueries(recursed, recursedSphereUsecs, recursedBoxUsecs);
+
+    std::cout << NUM_ENTITIES << " entities, " << NUM_QUERIES << " queries, usecs per query" << std::endl;
+    std::cout << "    sphere: octree " << (float)recursedSphereUsecs / NUM_QUERIES
+        << " index " << (float)indexedSphereUsecs / NUM_QUERIES << std::endl;
+    std::cout << "    box:    octree " << (float)recursedBoxUsecs / NUM_QUERIES
+        << " index " << (float)indexedBoxUsecs / NUM_QUERIES << std::endl;
+}
+#endif // MANUAL_TEST
@@ -0,0 +1,66 @@
+//
+//  EntityTestUtils.h
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTestUtils_h
+#define hifi_EntityTestUtils_h
+
+#include <vector>
+
+#include <AddEntityOperator.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTypes.h>
+#include <SharedUtil.h>
+
+// The entity trees and scenes of boxes the entity tests build
+
+inline EntityTreePointer createEntityTree(bool useSpatialIndex = true) {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setUseSpatialIndex(useSpatialIndex);
+    return tree;
+}
+
+// A random position in the cube of the given width centered on the origin
+inline glm::vec3 randomPosition(float worldWidth) {
+    return worldWidth * glm::vec3(randFloat() - 0.5f, randFloat() - 0.5f, randFloat() - 0.5f);
+}
+
+inline EntityItemPointer addBox(const EntityTreePointer& tree, const glm::vec3& position, const glm::vec3& dimensions,
+                                const QString& name = QString()) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(position);
+    properties.setDimensions(dimensions);
+    if (!name.isEmpty()) {
+        properties.setName(name);
+    }
+
+    auto entity = EntityTypes::constructEntityItem(EntityTypes::Box, EntityItemID(QUuid::createUuid()), properties);
+    entity->updateQueryAACube();
+
+    AddEntityOperator theOperator(tree, entity);
+    tree->recurseTreeWithOperator(&theOperator);
+    return entity;
+}
+
+// Adds boxes at random positions in the cube of the given width, with random sizes between the given dimensions
+inline std::vector<EntityItemPointer> addRandomBoxes(const EntityTreePointer& tree, int numEntities, float worldWidth,
+                                                     float minDimension, float maxDimension) {
+    std::vector<EntityItemPointer> entities;
+    for (int i = 0; i < numEntities; ++i) {
+        glm::vec3 dimensions = glm::vec3(minDimension + (maxDimension - minDimension) * randFloat());
+        entities.push_back(addBox(tree, randomPosition(worldWidth), dimensions));
+    }
+    return entities;
+}
+
+#endif // hifi_EntityTestUtils_h
@@ -0,0 +1,199 @@
+//
+//  EntityTreeElementTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeElementTests.h"
+
+#include <iostream>
+#include <set>
+
+#include <DiffTraversal.h>
+#include <OctreeElementPool.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityTreeElementTests)
+
+const float WORLD_WIDTH = 1000.0f;
+
+// the elements are what is tested, so the spatial index is left out
+static EntityTreePointer createTree() {
+    return createEntityTree(false);
+}
+
+static void buildScene(const EntityTreePointer& tree, int numEntities) {
+    addRandomBoxes(tree, numEntities, WORLD_WIDTH, 0.1f, 1.1f);
+}
+
+static std::vector<int> childIndices(const OctreeElementPointer& element) {
+    std::vector<int> indices;
+    element->forEachChild([&](int childIndex, const OctreeElementPointer& child) {
+        indices.push_back(childIndex);
+    });
+    return indices;
+}
+
+void EntityTreeElementTests::testChildren() {
+    auto tree = createTree();
+    OctreeElementPointer root = tree->getRoot();
+    QVERIFY(root->isLeaf());
+
+    // add children out of order, they are always kept in child index order
+    OctreeElementPointer children[NUMBER_OF_CHILDREN];
+    for (int childIndex : { 5, 1, 7, 0 }) {
+        children[childIndex] = root->addChildAtIndex(childIndex);
+        QVERIFY(children[childIndex]);
+    }
+    QCOMPARE(root->getChildCount(), 4);
+    QCOMPARE(childIndices(root), std::vector<int>({ 0, 1, 5, 7 }));
+
+    for (int childIndex = 0; childIndex < NUMBER_OF_CHILDREN; ++childIndex) {
+        QCOMPARE(root->hasChildAtIndex(childIndex), (bool)children[childIndex]);
+        QCOMPARE(root->getChildAtIndex(childIndex), children[childIndex]);
+    }
+
+    // adding an existing child returns the one that is there
+    QCOMPARE(root->addChildAtIndex(5), children[5]);
+    QCOMPARE(root->getChildCount(), 4);
+
+    // removing children keeps the others where they were
+    QCOMPARE(root->removeChildAtIndex(1), children[1]);
+    children[1].reset();
+    root->deleteChildAtIndex(7);
+    children[7].reset();
+    QCOMPARE(childIndices(root), std::vector<int>({ 0, 5 }));
+    QCOMPARE(root->getChildAtIndex(0), children[0]);
+    QCOMPARE(root->getChildAtIndex(5), children[5]);
+    QVERIFY(!root->getChildAtIndex(1));
+    QVERIFY(!root->getChildAtIndex(7));
+
+    root->deleteChildAtIndex(0);
+    root->deleteChildAtIndex(5);
+    QVERIFY(root->isLeaf());
+    QVERIFY(childIndices(root).empty());
+    QVERIFY(!root->getChildAtIndex(5));
+}
+
+void EntityTreeElementTests::testTraversalOrder() {
+    auto tree = createTree();
+    buildScene(tree, 2000);
+
+    // every element reports the same children by index and by iteration, and they are inside it
+    int numElements = 0;
+    int numMismatches = 0;
+    tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+        ++numElements;
+        int previousIndex = -1;
+        int numChildren = 0;
+        element->forEachChild([&](int childIndex, const OctreeElementPointer& child) {
+            if (childIndex <= previousIndex || element->getChildAtIndex(childIndex) != child ||
+                !element->getAACube().contains(child->getAACube())) {
+                ++numMismatches;
+            }
+            previousIndex = childIndex;
+            ++numChildren;
+        });
+        if (numChildren != element->getChildCount()) {
+            ++numMismatches;
+        }
+        return true;
+    });
+    QVERIFY(numElements > 1);
+    QCOMPARE(numMismatches, 0);
+}
+
+void EntityTreeElementTests::testPool() {
+    const size_t BLOCK_SIZE = 24;
+    const size_t BLOCKS_PER_SLAB = 4;
+    OctreeElementPool pool(BLOCK_SIZE, BLOCKS_PER_SLAB);
+    QVERIFY(pool.getBlockSize() >= BLOCK_SIZE);
+    QCOMPARE(pool.getBlockSize() % alignof(std::max_align_t), (size_t)0);
+
+    std::set<void*> blocks;
+    for (size_t i = 0; i < 10; ++i) {
+        void* block = pool.allocate(BLOCK_SIZE);
+        QCOMPARE((size_t)block % alignof(std::max_align_t), (size_t)0);
+        blocks.insert(block);
+    }
+    QCOMPARE(blocks.size(), (size_t)10);
+    QCOMPARE(pool.getNumAllocated(), (size_t)10);
+    QCOMPARE(pool.getNumSlabs(), (size_t)3);
+
+    // larger sizes bypass the pool
+    void* large = pool.allocate(2 * pool.getBlockSize());
+    QCOMPARE(pool.getNumAllocated(), (size_t)10);
+    pool.deallocate(large, 2 * pool.getBlockSize());
+
+    // freed blocks are reused before any new slab
+    for (auto block : blocks) {
+        pool.deallocate(block, BLOCK_SIZE);
+    }
+    QCOMPARE(pool.getNumAllocated(), (size_t)0);
+    for (size_t i = 0; i < 10; ++i) {
+        QVERIFY(blocks.count(pool.allocate(BLOCK_SIZE)) == 1);
+    }
+    QCOMPARE(pool.getNumSlabs(), (size_t)3);
+}
+
+#ifdef MANUAL_TEST
+void EntityTreeElementTests::benchmarkTraversal() {
+    const int NUM_ENTITIES = 100000;
+    const int NUM_TRAVERSALS = 100;
+    const uint64_t TRAVERSAL_BUDGET = 60 * USECS_PER_SECOND;
+
+    auto tree = createTree();
+    buildScene(tree, NUM_ENTITIES);
+
+    int numElements = 0;
+    uint64_t startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_TRAVERSALS; ++i) {
+        numElements = 0;
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            ++numElements;
+            return true;
+        });
+    }
+    uint64_t recurseUsecs = usecTimestampNow() - startTime;
+
+    // the traversal an entity server runs for a client with no view frustum
+    DiffTraversal traversal;
+    DiffTraversal::View view;
+    int numScanned = 0;
+    startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_TRAVERSALS; ++i) {
+        traversal.reset();
+        traversal.prepareNewTraversal(view, tree->getRoot());
+        numScanned = 0;
+        traversal.setScanCallback([&](DiffTraversal::VisibleElement& next) {
+            next.element->forEachEntity([&](EntityItemPointer entity) {
+                ++numScanned;
+            });
+        });
+        traversal.traverse(TRAVERSAL_BUDGET);
+    }
+    uint64_t diffUsecs = usecTimestampNow() - startTime;
+
+    QVector<EntityItemPointer> found;
+    startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_TRAVERSALS; ++i) {
+        tree->findEntities(AACube(glm::vec3(-WORLD_WIDTH), 2.0f * WORLD_WIDTH), found);
+    }
+    uint64_t findUsecs = usecTimestampNow() - startTime;
+
+    const auto& pool = EntityTreeElement::getElementPool();
+    std::cout << NUM_ENTITIES << " entities in " << numElements << " elements, "
+        << pool.getNumSlabs() << " slabs of elements" << std::endl;
+    std::cout << "    usecs per recursion " << (float)recurseUsecs / NUM_TRAVERSALS << std::endl;
+    std::cout << "    usecs per diff traversal " << (float)diffUsecs / NUM_TRAVERSALS
+        << " (" << numScanned << " entities)" << std::endl;
+    std::cout << "    usecs per findEntities " << (float)findUsecs / NUM_TRAVERSALS
+        << " (" << found.size() << " entities)" << std::endl;
+}
+#endif // MANUAL_TEST
@@ -0,0 +1,31 @@
+//
+//  EntityTreeElementTests.h
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeElementTests_h
+#define hifi_EntityTreeElementTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class EntityTreeElementTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testChildren();
+    void testTraversalOrder();
+    void testPool();
+#ifdef MANUAL_TEST
+    void benchmarkTraversal();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_EntityTreeElementTests_h
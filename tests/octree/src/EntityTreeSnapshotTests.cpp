@@ -0,0 +1,84 @@
+//
+//  EntityTreeSnapshotTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeSnapshotTests.h"
+
+#include <EntityTreeSnapshot.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityTreeSnapshotTests)
+
+const int NUM_ENTITIES = 50;
+
+static EntityTreePointer buildScene(std::vector<EntityItemPointer>& entities) {
+    auto tree = createEntityTree();
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entities.push_back(addBox(tree, glm::vec3((float)i, 0.0f, 0.0f), glm::vec3(0.5f), QString("box %1").arg(i)));
+    }
+    return tree;
+}
+
+static QStringList names(const QVariantList& entities) {
+    QStringList result;
+    for (const auto& entity : entities) {
+        result << entity.toMap()["name"].toString();
+    }
+    result.sort();
+    return result;
+}
+
+void EntityTreeSnapshotTests::testConvertsEveryEntity() {
+    std::vector<EntityItemPointer> entities;
+    auto tree = buildScene(entities);
+
+    EntityTreeSnapshot snapshot(*tree, nullptr, true, true);
+    QCOMPARE(snapshot.size(), NUM_ENTITIES);
+
+    QVariantList converted;
+    snapshot.appendTo(converted);
+    QCOMPARE(converted.size(), NUM_ENTITIES);
+
+    QStringList expected;
+    for (const auto& entity : entities) {
+        expected << entity->getName();
+    }
+    expected.sort();
+    QCOMPARE(names(converted), expected);
+
+    // default values are only written when asked for
+    QVariantList withDefaults;
+    EntityTreeSnapshot(*tree, nullptr, false, true).appendTo(withDefaults);
+    QCOMPARE(names(withDefaults), expected);
+    QVERIFY(withDefaults.front().toMap().size() > converted.front().toMap().size());
+}
+
+void EntityTreeSnapshotTests::testEditAfterSnapshot() {
+    std::vector<EntityItemPointer> entities;
+    auto tree = buildScene(entities);
+
+    // every entity is written as it was when the snapshot was taken, whether or not it changed before
+    entities.back()->setName("edited before the snapshot");
+    entities.back()->markAsChangedOnServer();
+    EntityTreeSnapshot snapshot(*tree, nullptr, true, true);
+    QString originalName = entities.front()->getName();
+    entities.front()->setName("edited after the snapshot");
+    entities.front()->markAsChangedOnServer();
+    entities.back()->setName("edited again after the snapshot");
+    entities.back()->markAsChangedOnServer();
+
+    QVariantList written;
+    snapshot.appendTo(written);
+    QVERIFY(names(written).contains(originalName));
+    QVERIFY(names(written).contains("edited before the snapshot"));
+    QVERIFY(!names(written).contains("edited after the snapshot"));
+    QVERIFY(!names(written).contains("edited again after the snapshot"));
+}
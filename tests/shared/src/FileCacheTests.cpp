@@ -58,8 +58,9 @@ void FileCacheTests::testUnusedFiles() {
         }
         QCOMPARE(cache->getNumCachedFiles(), (size_t)0);
         QCOMPARE(cache->getNumTotalFiles(), (size_t)100);
-        // Release the in-use files
+        // Release the in-use files, and wait for the eviction they trigger
         inUseFiles.clear();
+        cache->waitForClean();
         QCOMPARE(cache->getNumCachedFiles(), (size_t)10);
         QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
         QVERIFY(getCacheDirectorySize() <= MAX_UNUSED_SIZE);
@@ -110,6 +111,7 @@ void FileCacheTests::testUnusedFiles() {
         QCOMPARE(cache->getNumCachedFiles(), (size_t)0);
         QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
         inUseFiles.clear();
+        cache->waitForClean();
         QCOMPARE(cache->getNumCachedFiles(), (size_t)10);
         QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
     }
@@ -130,6 +132,7 @@ void FileCacheTests::testFreeSpacePreservation() {
     auto cache = makeFileCache(_testDir.path());
     // Setting the min free space causes it to eject the oldest files that cause the cache to exceed the minimum space
     cache->setMinFreeSize(targetFreeSpace);
+    cache->waitForClean();
     QCOMPARE(cache->getNumCachedFiles(), (size_t)5);
     QCOMPARE(cache->getNumTotalFiles(), (size_t)5);
     QVERIFY(getFreeSpace() >= targetFreeSpace);
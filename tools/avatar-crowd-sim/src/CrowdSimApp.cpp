@@ -0,0 +1,423 @@
+//
+//  CrowdSimApp.cpp
+//  tools/avatar-crowd-sim/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdSimApp.h"
+
+#include <algorithm>
+
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <GLMHelpers.h>
+#include <NLPacket.h>
+#include <NumericalConstants.h>
+#include <PrioritySortUtil.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+#include <recording/Clip.h>
+#include <recording/Frame.h>
+#include <shared/ConicalViewFrustum.h>
+
+// the avatar mixer broadcasts at this rate, keep in sync with AvatarMixerSlave
+static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
+static const float SIMULATION_TIMESTEP = 1.0f / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+
+static const int DEFAULT_NUM_AVATARS = 1000;
+static const int DEFAULT_NUM_LISTENERS = 100;
+static const int DEFAULT_NUM_FRAMES = 450;
+static const float DEFAULT_CROWD_RADIUS = 50.0f; // meters
+static const float DEFAULT_MAX_KBPS_PER_LISTENER = 5000.0f; // matches the avatar mixer default of 5 Mbps
+
+static const int NUM_SYNTHETIC_JOINTS = 60;
+
+// the synthetic avatars need a bounding box so the mixer side sort has a radius to work with
+class CrowdAvatar : public AvatarData {
+public:
+    CrowdAvatar() {
+        static const glm::vec3 AVATAR_DIMENSIONS { 0.6f, 1.8f, 0.6f };
+        static const glm::vec3 AVATAR_BOX_OFFSET { 0.0f, -0.9f, 0.0f };
+        _globalBoundingBoxDimensions = AVATAR_DIMENSIONS;
+        _globalBoundingBoxOffset = AVATAR_BOX_OFFSET;
+    }
+};
+
+CrowdSimApp::CrowdSimApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv),
+    _generator(0)
+{
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity avatar crowd simulator and avatar mixer benchmark");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption avatarsOption("n", "number of simulated avatars", QString::number(DEFAULT_NUM_AVATARS));
+    parser.addOption(avatarsOption);
+
+    const QCommandLineOption listenersOption("l", "number of avatars that also listen",
+                                             QString::number(DEFAULT_NUM_LISTENERS));
+    parser.addOption(listenersOption);
+
+    const QCommandLineOption framesOption("f", "number of mixer frames to simulate", QString::number(DEFAULT_NUM_FRAMES));
+    parser.addOption(framesOption);
+
+    const QCommandLineOption radiusOption("r", "radius of the crowd in meters", QString::number(DEFAULT_CROWD_RADIUS));
+    parser.addOption(radiusOption);
+
+    const QCommandLineOption kbpsOption("k", "max kbps sent to each listener",
+                                        QString::number(DEFAULT_MAX_KBPS_PER_LISTENER));
+    parser.addOption(kbpsOption);
+
+    const QCommandLineOption clipOption("c", "recording clip to replay joint data from", "filename.hfr");
+    parser.addOption(clipOption);
+
+    const QCommandLineOption seedOption("s", "random seed for avatar placement", "0");
+    parser.addOption(seedOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    _verbose = parser.isSet(verboseOutput);
+
+    int numAvatars = parser.isSet(avatarsOption) ? parser.value(avatarsOption).toInt() : DEFAULT_NUM_AVATARS;
+    int numListeners = parser.isSet(listenersOption) ? parser.value(listenersOption).toInt() : DEFAULT_NUM_LISTENERS;
+    int numFrames = parser.isSet(framesOption) ? parser.value(framesOption).toInt() : DEFAULT_NUM_FRAMES;
+    float crowdRadius = parser.isSet(radiusOption) ? parser.value(radiusOption).toFloat() : DEFAULT_CROWD_RADIUS;
+    _maxKbpsPerListener = parser.isSet(kbpsOption) ? parser.value(kbpsOption).toFloat() : DEFAULT_MAX_KBPS_PER_LISTENER;
+
+    if (parser.isSet(seedOption)) {
+        _generator.seed(parser.value(seedOption).toUInt());
+    }
+
+    if (numAvatars <= 0 || numFrames <= 0) {
+        qCritical() << "The number of avatars and frames must be positive";
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(clipOption)) {
+        if (!loadClip(parser.value(clipOption))) {
+            _returnCode = 2;
+            return;
+        }
+    } else {
+        generateSyntheticPose();
+    }
+
+    setupCrowd(numAvatars, std::min(std::max(numListeners, 0), numAvatars), crowdRadius);
+
+    std::vector<CrowdSimFrameStats> frameStats;
+    frameStats.reserve(numFrames);
+
+    for (int frame = 0; frame < numFrames; ++frame) {
+        CrowdSimFrameStats stats;
+
+        simulateAvatars(frame * SIMULATION_TIMESTEP);
+        processIncomingAvatarData(stats);
+        broadcastAvatarData(stats);
+
+        if (_verbose) {
+            qDebug() << "frame" << frame << "parse" << stats.parseElapsedTime << "us broadcast"
+                << stats.broadcastElapsedTime << "us bytes" << stats.bytesSent;
+        }
+
+        frameStats.push_back(stats);
+    }
+
+    printReport(frameStats);
+}
+
+bool CrowdSimApp::loadClip(const QString& clipPath) {
+    auto clip = recording::Clip::fromFile(clipPath);
+    if (!clip) {
+        qCritical() << "Failed to load recording" << clipPath;
+        return false;
+    }
+
+    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+
+    // decode every avatar frame once up front, so the benchmark measures the mixer and not JSON parsing
+    CrowdAvatar scratchAvatar;
+    clip->seek(0.0f);
+    for (size_t i = 0; i < clip->frameCount(); ++i) {
+        auto frame = clip->nextFrame();
+        if (!frame || frame->type != AVATAR_FRAME_TYPE) {
+            continue;
+        }
+
+        AvatarData::fromFrame(frame->data, scratchAvatar, false);
+        _clipPoses.push_back({ recording::Frame::frameTimeToSeconds(frame->timeOffset), scratchAvatar.getRawJointData() });
+    }
+
+    if (_clipPoses.empty()) {
+        qCritical() << "Recording" << clipPath << "has no avatar frames";
+        return false;
+    }
+
+    _clipDuration = std::max(clip->duration(), _clipPoses.back().time);
+    qDebug() << "Replaying" << _clipPoses.size() << "avatar frames from" << clipPath;
+    return true;
+}
+
+void CrowdSimApp::generateSyntheticPose() {
+    // without a recording, sway every joint back and forth at a slightly different rate
+    // so the mixer sees a realistic mix of changed and unchanged rotations each frame
+    static const float SYNTHETIC_CLIP_DURATION = 2.0f; // seconds
+    static const float MAX_SWAY_ANGLE = 0.25f; // radians
+    int numPoses = (int)(SYNTHETIC_CLIP_DURATION * AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+
+    for (int poseIndex = 0; poseIndex < numPoses; ++poseIndex) {
+        float time = poseIndex * SIMULATION_TIMESTEP;
+        QVector<JointData> joints(NUM_SYNTHETIC_JOINTS);
+        for (int jointIndex = 0; jointIndex < NUM_SYNTHETIC_JOINTS; ++jointIndex) {
+            auto& joint = joints[jointIndex];
+            float angle = MAX_SWAY_ANGLE * sinf(TWO_PI * time / SYNTHETIC_CLIP_DURATION + jointIndex);
+            joint.rotation = glm::angleAxis(angle, jointIndex % 2 ? Vectors::UNIT_X : Vectors::UNIT_Z);
+            joint.rotationIsDefaultPose = false;
+            joint.translationIsDefaultPose = true;
+        }
+        _clipPoses.push_back({ time, joints });
+    }
+
+    _clipDuration = SYNTHETIC_CLIP_DURATION;
+}
+
+const QVector<JointData>& CrowdSimApp::poseAtTime(float time) const {
+    float clipTime = _clipDuration > 0.0f ? fmodf(time, _clipDuration) : 0.0f;
+    auto it = std::upper_bound(_clipPoses.begin(), _clipPoses.end(), clipTime, [](float value, const ClipPose& pose) {
+        return value < pose.time;
+    });
+    if (it != _clipPoses.begin()) {
+        --it;
+    }
+    return it->joints;
+}
+
+void CrowdSimApp::setupCrowd(int numAvatars, int numListeners, float crowdRadius) {
+    std::uniform_real_distribution<float> unitDistribution;
+
+    static const float MIN_PATH_RADIUS = 1.0f; // meters
+    static const float MAX_PATH_RADIUS = 10.0f; // meters
+    static const float MAX_WALK_SPEED = 1.5f; // meters per second
+
+    _avatars.resize(numAvatars);
+    for (int i = 0; i < numAvatars; ++i) {
+        auto& avatar = _avatars[i];
+
+        avatar.client = std::unique_ptr<AvatarData>(new CrowdAvatar());
+        avatar.mixer = std::unique_ptr<AvatarData>(new AvatarData());
+
+        auto sessionUUID = QUuid::createUuid();
+        avatar.client->setSessionUUID(sessionUUID);
+        avatar.mixer->setSessionUUID(sessionUUID);
+
+        // scatter path centers uniformly over a disc
+        float centerAngle = TWO_PI * unitDistribution(_generator);
+        float centerDistance = crowdRadius * sqrtf(unitDistribution(_generator));
+        avatar.pathCenter = glm::vec3(centerDistance * cosf(centerAngle), 0.0f, centerDistance * sinf(centerAngle));
+        avatar.pathRadius = MIN_PATH_RADIUS + (MAX_PATH_RADIUS - MIN_PATH_RADIUS) * unitDistribution(_generator);
+        avatar.angularSpeed = MAX_WALK_SPEED * unitDistribution(_generator) / avatar.pathRadius;
+        avatar.phase = TWO_PI * unitDistribution(_generator);
+        avatar.clipOffset = _clipDuration * unitDistribution(_generator);
+    }
+
+    _listeners.resize(numListeners);
+    for (int i = 0; i < numListeners; ++i) {
+        auto& listener = _listeners[i];
+        listener.avatarIndex = i;
+        listener.lastSentJoints.resize(numAvatars);
+        listener.lastEncodeTimes.resize(numAvatars, 0);
+    }
+
+    qDebug() << "Simulating" << numAvatars << "avatars," << numListeners << "listeners, crowd radius" << crowdRadius << "m";
+}
+
+void CrowdSimApp::simulateAvatars(float simulationTime) {
+    for (auto& avatar : _avatars) {
+        float angle = avatar.phase + avatar.angularSpeed * simulationTime;
+        glm::vec3 offset(cosf(angle), 0.0f, sinf(angle));
+
+        // walk the circle, facing along the tangent
+        avatar.client->setWorldPosition(avatar.pathCenter + avatar.pathRadius * offset);
+        avatar.client->setWorldOrientation(glm::angleAxis(-angle, Vectors::UNIT_Y));
+        avatar.client->setRawJointData(poseAtTime(simulationTime + avatar.clipOffset));
+    }
+}
+
+void CrowdSimApp::processIncomingAvatarData(CrowdSimFrameStats& stats) {
+    std::uniform_real_distribution<float> distribution;
+
+    for (auto& avatar : _avatars) {
+        // encode the way MyAvatar::sendAvatarDataPacket does, this is not part of the mixer frame time
+        bool cullSmallData = distribution(_generator) >= AVATAR_SEND_FULL_UPDATE_RATIO;
+        auto dataDetail = cullSmallData ? AvatarData::CullSmallData : AvatarData::SendAllData;
+        QByteArray avatarByteArray = avatar.client->toByteArrayStateful(dataDetail);
+        avatar.client->doneEncoding(cullSmallData);
+
+        quint64 start = usecTimestampNow();
+        avatar.mixer->parseDataFromBuffer(avatarByteArray);
+        stats.parseElapsedTime += usecTimestampNow() - start;
+    }
+}
+
+void CrowdSimApp::broadcastAvatarData(CrowdSimFrameStats& stats) {
+    quint64 start = usecTimestampNow();
+    for (auto& listener : _listeners) {
+        broadcastToListener(listener, stats);
+    }
+    stats.broadcastElapsedTime += usecTimestampNow() - start;
+}
+
+void CrowdSimApp::broadcastToListener(SimulatedListener& listener, CrowdSimFrameStats& stats) {
+    // this mirrors the budgeting in AvatarMixerSlave::broadcastAvatarDataToAgent, minus the ignore and PAL handling
+    const AvatarData& listenerAvatar = *_avatars[listener.avatarIndex].mixer;
+    glm::vec3 listenerPosition = listenerAvatar.getClientGlobalPosition();
+
+    ViewFrustum viewFrustum;
+    viewFrustum.setPosition(listenerPosition);
+    viewFrustum.setOrientation(_avatars[listener.avatarIndex].client->getWorldOrientation());
+    viewFrustum.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+    viewFrustum.calculate();
+    ConicalViewFrustums cameraViews { ConicalViewFrustum(viewFrustum) };
+
+    class SortableAvatar : public PrioritySortUtil::Sortable {
+    public:
+        SortableAvatar() = delete;
+        SortableAvatar(const AvatarData* avatar, int index, uint64_t lastEncodeTime) :
+            _avatar(avatar), _index(index), _lastEncodeTime(lastEncodeTime) {}
+        glm::vec3 getPosition() const override { return _avatar->getClientGlobalPosition(); }
+        float getRadius() const override {
+            glm::vec3 nodeBoxScale = _avatar->getGlobalBoundingBox().getScale();
+            return 0.5f * glm::max(nodeBoxScale.x, glm::max(nodeBoxScale.y, nodeBoxScale.z));
+        }
+        uint64_t getTimestamp() const override { return _lastEncodeTime; }
+        int getIndex() const { return _index; }
+
+    private:
+        const AvatarData* _avatar;
+        int _index;
+        uint64_t _lastEncodeTime;
+    };
+
+    PrioritySortUtil::PriorityQueue<SortableAvatar> sortedAvatars(cameraViews,
+            AvatarData::_avatarSortCoefficientSize,
+            AvatarData::_avatarSortCoefficientCenter,
+            AvatarData::_avatarSortCoefficientAge);
+    sortedAvatars.reserve(_avatars.size());
+
+    for (int i = 0; i < (int)_avatars.size(); ++i) {
+        if (i != listener.avatarIndex) {
+            sortedAvatars.push(SortableAvatar(_avatars[i].mixer.get(), i, listener.lastEncodeTimes[i]));
+        }
+    }
+
+    int maxAvatarBytesPerFrame = int(_maxKbpsPerListener * BYTES_PER_KILOBIT / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+    const int avatarPacketCapacity = NLPacket::maxPayloadSize(PacketType::BulkAvatarData);
+    int avatarSpaceAvailable = avatarPacketCapacity;
+    int numAvatarDataBytes = 0;
+    int remainingAvatars = (int)sortedAvatars.size();
+
+    std::uniform_real_distribution<float> distribution;
+
+    stats.othersConsidered += remainingAvatars;
+
+    const auto& sortedAvatarVector = sortedAvatars.getSortedVector();
+    for (const auto& sortedAvatar : sortedAvatarVector) {
+        if (numAvatarDataBytes > maxAvatarBytesPerFrame) {
+            stats.overBudgetAvatars += remainingAvatars;
+            break;
+        }
+
+        int otherIndex = sortedAvatar.getIndex();
+        const AvatarData* otherAvatar = _avatars[otherIndex].mixer.get();
+
+        AvatarData::AvatarDataDetail detail;
+        if (sortedAvatar.getPriority() <= OUT_OF_VIEW_THRESHOLD) {
+            detail = AvatarData::MinimumData;
+        } else {
+            detail = distribution(_generator) < AVATAR_SEND_FULL_UPDATE_RATIO ?
+                AvatarData::SendAllData : AvatarData::CullSmallData;
+        }
+
+        QVector<JointData>& lastSentJointsForOther = listener.lastSentJoints[otherIndex];
+
+        AvatarDataPacket::SendStatus sendStatus;
+        sendStatus.sendUUID = true;
+
+        do {
+            QByteArray bytes = otherAvatar->toByteArray(detail, sortedAvatar.getTimestamp(), lastSentJointsForOther,
+                sendStatus, false, true, listenerPosition, &lastSentJointsForOther, avatarSpaceAvailable);
+
+            avatarSpaceAvailable -= bytes.size();
+            numAvatarDataBytes += bytes.size();
+            if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                // this is where the mixer would send the packet and start another
+                avatarSpaceAvailable = avatarPacketCapacity;
+            }
+        } while (!sendStatus);
+
+        listener.lastEncodeTimes[otherIndex] = usecTimestampNow();
+        remainingAvatars--;
+    }
+
+    stats.bytesSent += numAvatarDataBytes;
+}
+
+void CrowdSimApp::printReport(const std::vector<CrowdSimFrameStats>& frameStats) const {
+    const quint64 FRAME_BUDGET_USECS = USECS_PER_SECOND / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+
+    quint64 totalParse = 0;
+    quint64 totalBroadcast = 0;
+    quint64 maxFrame = 0;
+    quint64 totalBytes = 0;
+    quint64 totalConsidered = 0;
+    quint64 totalOverBudget = 0;
+    int framesOverTime = 0;
+
+    for (const auto& stats : frameStats) {
+        quint64 frameTime = stats.parseElapsedTime + stats.broadcastElapsedTime;
+        totalParse += stats.parseElapsedTime;
+        totalBroadcast += stats.broadcastElapsedTime;
+        maxFrame = std::max(maxFrame, frameTime);
+        totalBytes += stats.bytesSent;
+        totalConsidered += stats.othersConsidered;
+        totalOverBudget += stats.overBudgetAvatars;
+        if (frameTime > FRAME_BUDGET_USECS) {
+            ++framesOverTime;
+        }
+    }
+
+    float numFrames = (float)frameStats.size();
+    float numListeners = (float)std::max((size_t)1, _listeners.size());
+    float bytesPerListenerPerFrame = totalBytes / numFrames / numListeners;
+    float kbpsPerListener = bytesPerListenerPerFrame * AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND / BYTES_PER_KILOBIT;
+
+    qDebug() << "avatars:" << _avatars.size() << "listeners:" << _listeners.size() << "frames:" << frameStats.size();
+    qDebug() << "avg parse time (us):" << totalParse / numFrames;
+    qDebug() << "avg broadcast time (us):" << totalBroadcast / numFrames;
+    qDebug() << "max frame time (us):" << maxFrame << "- frames over" << FRAME_BUDGET_USECS << "us:" << framesOverTime;
+    qDebug() << "avg bytes per listener per frame:" << bytesPerListenerPerFrame << "(" << kbpsPerListener << "kbps )";
+    qDebug() << "over budget avatar ratio:" << (totalConsidered > 0 ? (float)totalOverBudget / totalConsidered : 0.0f);
+}
@@ -0,0 +1,88 @@
+//
+//  CrowdSimApp.h
+//  tools/avatar-crowd-sim/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdSimApp_h
+#define hifi_CrowdSimApp_h
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <QCoreApplication>
+
+#include <AvatarData.h>
+
+// A single synthetic avatar in the crowd.
+// The client side is the AvatarData an interface or agent would encode and send,
+// the mixer side is the copy the avatar mixer would decode from that data and broadcast from.
+struct SimulatedAvatar {
+    std::unique_ptr<AvatarData> client;
+    std::unique_ptr<AvatarData> mixer;
+
+    glm::vec3 pathCenter;
+    float pathRadius { 0.0f };
+    float angularSpeed { 0.0f };
+    float phase { 0.0f };
+    float clipOffset { 0.0f };
+};
+
+// Per listener state that AvatarMixerClientData keeps for each other avatar
+struct SimulatedListener {
+    int avatarIndex { 0 };
+    std::vector<QVector<JointData>> lastSentJoints;
+    std::vector<uint64_t> lastEncodeTimes;
+};
+
+struct CrowdSimFrameStats {
+    quint64 parseElapsedTime { 0 };
+    quint64 broadcastElapsedTime { 0 };
+    quint64 bytesSent { 0 };
+    int othersConsidered { 0 };
+    int overBudgetAvatars { 0 };
+};
+
+class CrowdSimApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    CrowdSimApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    bool loadClip(const QString& clipPath);
+    void generateSyntheticPose();
+    void setupCrowd(int numAvatars, int numListeners, float crowdRadius);
+
+    void simulateAvatars(float simulationTime);
+    void processIncomingAvatarData(CrowdSimFrameStats& stats);
+    void broadcastAvatarData(CrowdSimFrameStats& stats);
+    void broadcastToListener(SimulatedListener& listener, CrowdSimFrameStats& stats);
+
+    void printReport(const std::vector<CrowdSimFrameStats>& frameStats) const;
+
+    struct ClipPose {
+        float time;
+        QVector<JointData> joints;
+    };
+    const QVector<JointData>& poseAtTime(float time) const;
+
+    std::vector<SimulatedAvatar> _avatars;
+    std::vector<SimulatedListener> _listeners;
+    std::vector<ClipPose> _clipPoses;
+    float _clipDuration { 0.0f };
+
+    std::mt19937 _generator;
+    float _maxKbpsPerListener { 0.0f };
+    bool _verbose { false };
+    int _returnCode { 0 };
+};
+
+#endif // hifi_CrowdSimApp_h
@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/avatar-crowd-sim/src
+//
+//  Created by agent on 10/18/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+
+#include <SharedUtil.h>
+
+#include "CrowdSimApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Avatar Crowd Simulator");
+
+    CrowdSimApp app(argc, argv);
+    return app.getReturnCode();
+}